@@ -0,0 +1,33 @@
+#include <Rcpp11>
+
+// entry points for lstsq.R
+
+extern "C" SEXP lstsq_vector( SEXP X, SEXP y, SEXP method ){
+    BEGIN_RCPP
+    return lstsq( NumericMatrix(X), NumericVector(y), as<std::string>(method) ) ;
+    END_RCPP
+}
+
+extern "C" SEXP lstsq_matrix( SEXP X, SEXP Y, SEXP method ){
+    BEGIN_RCPP
+    return lstsq( NumericMatrix(X), NumericMatrix(Y), as<std::string>(method) ) ;
+    END_RCPP
+}
+
+// one fit per column of Y, each with its own decomposition, as a loop
+// over lm.fit does
+extern "C" SEXP lstsq_loop( SEXP X, SEXP Y, SEXP method ){
+    BEGIN_RCPP
+    NumericMatrix x(X), ys(Y) ;
+    std::string m = as<std::string>(method) ;
+    int n = ys.nrow(), q = ys.ncol() ;
+    NumericMatrix res( x.ncol(), q ) ;
+    for( int j=0; j<q; j++){
+        NumericVector y( n ) ;
+        std::copy( ys.begin() + static_cast<R_xlen_t>(n) * j, ys.begin() + static_cast<R_xlen_t>(n) * (j + 1), y.begin() ) ;
+        NumericVector b = lstsq( x, y, m ) ;
+        std::copy( b.begin(), b.end(), res.begin() + static_cast<R_xlen_t>(x.ncol()) * j ) ;
+    }
+    return res ;
+    END_RCPP
+}
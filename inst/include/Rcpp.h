@@ -13,6 +13,35 @@
     #define RCPP11_PARALLEL_NTHREADS std::thread::hardware_concurrency()
 #endif
 
+// number of elements a thread processes before checking whether the 
+// parallel job has been cancelled
+#ifndef RCPP11_PARALLEL_BLOCK_SIZE
+    #define RCPP11_PARALLEL_BLOCK_SIZE 4096
+#endif
+
+// minimum number of milliseconds between two checks for user interrupts
+// in long running loops
+#ifndef RCPP11_INTERRUPT_CHECK_INTERVAL
+    #define RCPP11_INTERRUPT_CHECK_INTERVAL 100
+#endif
+
+// minimum number of names for offsets(names) to look several names up 
+// through a hash index of the names instead of linear searches
+#ifndef RCPP11_NAME_INDEX_MINIMUM_SIZE
+    #define RCPP11_NAME_INDEX_MINIMUM_SIZE 32
+#endif
+
+// whether exceptions record the call stack, can be changed at runtime with 
+// Rcpp::exception_backtrace(bool)
+#ifndef RCPP11_EXCEPTION_BACKTRACE
+    #define RCPP11_EXCEPTION_BACKTRACE true
+#endif
+
+// define RCPP11_USE_BLAS to use the BLAS R is linked against for matrix 
+// products (matmul, crossprod, tcrossprod). The package then needs 
+// PKG_LIBS = $(BLAS_LIBS) $(FLIBS) in its Makevars
+// #define RCPP11_USE_BLAS
+
 
 #include <Rcpp/platform.h>
 
@@ -53,6 +82,7 @@
 #include <vector>
 #include <deque>
 #include <functional>
+#include <memory>
 #include <numeric>
 #include <algorithm>
 #include <complex>
@@ -73,6 +103,9 @@
 #include <Rcpp/utils/describe.h>
 
 #include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
 #include <Rcpp/utils/parallel/parallel.h>
 
 namespace Rcpp{
@@ -100,7 +133,7 @@ namespace Rcpp{
         // simple test for exact match
         if( ! clazz.compare( CHAR(STRING_ELT(cl, 0)) ) ) return true ;
 
-        SEXP containsSym = Rf_install("contains");
+        SEXP containsSym = RCPP_SYMBOL("contains");
         Shield<SEXP> contains = R_do_slot(R_getClassDef(CHAR(Rf_asChar(cl))),containsSym);
         SEXP res = Rf_getAttrib(contains,R_NamesSymbol );
         if(res == R_NilValue) return false ;
@@ -209,13 +242,16 @@ namespace Rcpp{
 #include <Rcpp/XPtr.h>
 #include <Rcpp/Function.h>
 #include <Rcpp/Language.h>
+#include <Rcpp/PreparedCall.h>
 #include <Rcpp/Pairlist.h>
 #include <Rcpp/StretchyList.h>
 #include <Rcpp/WeakReference.h>
 #include <Rcpp/Formula.h>
 #include <Rcpp/DataFrame.h>
 #include <Rcpp/Index.h>
+#include <Rcpp/ArraySlice.h>
 #include <Rcpp/Array.h>
+#include <Rcpp/SparseMatrix.h>
 #include <Rcpp/Dots.h>
 #include <Rcpp/NamedDots.h>
 
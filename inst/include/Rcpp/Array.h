@@ -8,9 +8,11 @@ namespace Rcpp{
     public:
         typedef Vector<RTYPE,Storage> Vec; 
         typedef typename Vec::Proxy Proxy;
+        typedef typename Vec::iterator iterator;
+        typedef typename Vec::const_iterator const_iterator;
         
         Array( SEXP x ) : index(), data(x) {
-            IntegerVector dim = attr(data, "dim") ;
+            IntegerVector dim = attr_sym(data, R_DimSymbol) ;
             if( dim.size() != N ) stop("incompatible dimensions") ;
             std::copy( dim.begin(), dim.end(), index.begin() ) ;
         }
@@ -20,10 +22,26 @@ namespace Rcpp{
             typename = typename std::enable_if< ValidIndexArgs<N,Args...>() >::type 
         >
         Array( Args... args ) : 
-            index({ static_cast<size_t>(args)... }), 
+            index( args... ), 
             data(index.prod())
         {
-            attr(data, "dim") = index ;    
+            attr_sym(data, R_DimSymbol) = index ;    
+        }
+        
+        template <typename S, int K>
+        Array( const ArraySlice<RTYPE,S,K,N>& slice ) : 
+            index( slice.get_dims() ), 
+            data(index.prod())
+        {
+            attr_sym(data, R_DimSymbol) = index ;
+            slice.apply(data) ;
+        }
+        
+        explicit Array( const std::array<int,N>& dims ) : 
+            index( dims ), 
+            data(index.prod())
+        {
+            attr_sym(data, R_DimSymbol) = index ;    
         }
         
         template < 
@@ -39,7 +57,7 @@ namespace Rcpp{
             typename = typename std::enable_if< ValidIndexArgs<N,Args...>() >::type
         >
         const Proxy operator()( Args... args) const {
-            return data[ index.get_index( args... ) ];    
+            return const_cast<Vec&>(data)[ index.get_index( args... ) ];    
         }
         
         inline operator SEXP() const { return data ; }
@@ -51,10 +69,29 @@ namespace Rcpp{
             return *this ;
         }
         
+        template <
+            typename... Args, 
+            typename = typename std::enable_if< ValidSliceArgs<N,Args...>() >::type
+        >
+        inline ArraySlice<RTYPE, Storage, N, internal::count_placeholders<Args...>::value> slice( Args... args ) const {
+            return ArraySlice<RTYPE, Storage, N, internal::count_placeholders<Args...>::value>( data, dims(), args... ) ;
+        }
+        
         inline int get_dim(int i) const {
             return index.get_dim(i) ;        
         }
         
+        inline const std::array<int,N>& dims() const {
+            return index.dims() ;    
+        }
+        
+        inline R_xlen_t size() const { return data.size() ; }
+        
+        inline iterator begin(){ return data.begin() ; }
+        inline iterator end(){ return data.end() ; }
+        inline const_iterator begin() const { return data.begin() ; }
+        inline const_iterator end() const { return data.end() ; }
+        
     private:
         Index<N> index ;
         Vec data ;
@@ -0,0 +1,156 @@
+#ifndef Rcpp__ArraySlice__h
+#define Rcpp__ArraySlice__h
+
+namespace Rcpp{
+
+    namespace sugar{
+        template <typename eT, typename T> class indexing_iterator ;
+    }
+    
+    namespace internal{
+
+        template <typename... Args>
+        struct count_placeholders : std::integral_constant<int, 0>{} ;
+
+        template <typename First, typename... Args>
+        struct count_placeholders<First, Args...> : std::integral_constant<int,
+            std::is_same< typename std::decay<First>::type, NamedPlaceHolder>::value + count_placeholders<Args...>::value
+        >{} ;
+
+    }
+
+    // each argument is either an index or the placeholder `_` for a whole dimension
+    template <int N, typename... Args>
+    constexpr bool ValidSliceArgs() {
+        return traits::and_< std::integral_constant<bool,
+            std::is_convertible<Args, int>::value || std::is_same< typename std::decay<Args>::type, internal::NamedPlaceHolder>::value
+        >... >::value && (N == sizeof...(Args) ) ;
+    }
+
+    // view of the elements of an N dimensional array where some indices are
+    // fixed, e.g. arr.slice(_, 3, _). The slice has M dimensions, one for each
+    // placeholder, and is a vector expression over its elements in column
+    // major order. Nothing is copied until the slice is used.
+    //
+    // The leading dimensions of the slice that are laid out contiguously in
+    // the array form runs, which are copied with std::copy, in parallel for
+    // atomic vectors
+    template <int RTYPE, typename Storage, int N, int M>
+    class ArraySlice :
+        public SugarVectorExpression< typename traits::storage_type<RTYPE>::type, ArraySlice<RTYPE,Storage,N,M> >,
+        public sugar::custom_sugar_vector_expression
+    {
+    public:
+        typedef typename traits::storage_type<RTYPE>::type value_type ;
+        typedef Vector<RTYPE,Storage> Vec ;
+        typedef sugar::indexing_iterator<value_type, ArraySlice> const_iterator ;
+
+        template <typename... Args>
+        ArraySlice( const Vec& data_, const std::array<int,N>& source_dims, Args... args ) :
+            data(data_), dims(), strides(), start(0), n(1), run(1), run_dims(0)
+        {
+            R_xlen_t stride = 1 ;
+            int k = 0, m = 0 ;
+            std::initializer_list<int>{ add( k++, m, stride, source_dims, args )... } ;
+            for( int i=0; i<M; i++) n *= dims[i] ;
+            for( ; run_dims<M && strides[run_dims] == run; run_dims++) run *= dims[run_dims] ;
+        }
+
+        inline R_xlen_t size() const { return n ; }
+
+        inline const std::array<int,M>& get_dims() const { return dims ; }
+
+        inline value_type operator[]( R_xlen_t i ) const {
+            R_xlen_t offset = start ;
+            for( int m=0; m<M; m++){
+                offset += ( i % dims[m] ) * strides[m] ;
+                i /= dims[m] ;
+            }
+            return data[offset] ;
+        }
+
+        template <
+            typename... Args,
+            typename = typename std::enable_if< ValidIndexArgs<M,Args...>() >::type
+        >
+        inline value_type operator()( Args... args ) const {
+            R_xlen_t offset = start ;
+            int m = 0 ;
+            std::initializer_list<int>{ ( offset += static_cast<R_xlen_t>(args) * strides[m++], 0 )... } ;
+            return data[offset] ;
+        }
+
+        inline const_iterator begin() const { return const_iterator( *this, 0 ) ; }
+        inline const_iterator end() const { return const_iterator( *this, size() ) ; }
+
+        template <typename Target>
+        inline void apply( Target& target ) const {
+            apply_parallel( target ) ;
+        }
+
+        template <typename Target>
+        inline void apply_serial( Target& target ) const {
+            copy_runs( target, false ) ;
+        }
+
+        template <typename Target>
+        inline void apply_parallel( Target& target ) const {
+            copy_runs( target, traits::is_primitive<value_type>::value ) ;
+        }
+
+    private:
+
+        inline int add( int k, int& m, R_xlen_t& stride, const std::array<int,N>& source_dims, internal::NamedPlaceHolder ){
+            dims[m] = source_dims[k] ;
+            strides[m] = stride ;
+            m++ ;
+            stride *= source_dims[k] ;
+            return 0 ;
+        }
+
+        inline int add( int k, int&, R_xlen_t& stride, const std::array<int,N>& source_dims, int i ){
+            if( i < 0 || i >= source_dims[k] ) stop( "subscript out of bounds" ) ;
+            start += stride * i ;
+            stride *= source_dims[k] ;
+            return 0 ;
+        }
+
+        // offset of the first element of a run in the array
+        inline R_xlen_t run_offset( R_xlen_t r ) const {
+            R_xlen_t offset = start ;
+            for( int m=run_dims; m<M; m++){
+                offset += ( r % dims[m] ) * strides[m] ;
+                r /= dims[m] ;
+            }
+            return offset ;
+        }
+
+        template <typename Target>
+        void copy_runs( Target& target, bool parallel ) const {
+            if( n == 0 ) return ;
+            auto out = target.begin() ;
+            auto in = const_cast<Vec&>(data).begin() ;
+            R_xlen_t nruns = n / run ;
+            auto process = [=]( R_xlen_t begin, R_xlen_t end ){
+                for( R_xlen_t r=begin; r<end; r++){
+                    auto first = in + run_offset(r) ;
+                    std::copy( first, first + run, out + r * run ) ;
+                }
+            } ;
+            if( parallel ){
+                parallel_for( 0, nruns, std::max<R_xlen_t>( 1, RCPP11_PARALLEL_MINIMUM_SIZE / run ), process ) ;
+            } else {
+                process( 0, nruns ) ;
+            }
+        }
+
+        Vec data ;
+        std::array<int,M> dims ;
+        std::array<R_xlen_t,M> strides ;
+        R_xlen_t start, n, run ;
+        int run_dims ;
+    } ;
+
+}
+
+#endif
@@ -31,7 +31,7 @@ namespace Rcpp {
             SET_STRING_ELT( names, 1, Rf_mkChar( "call" ) ) ;
             Rf_setAttrib( cond, R_NamesSymbol, names ) ;
             Rf_setAttrib( cond, R_ClassSymbol, get_exception_classes() ) ;
-            Shield<SEXP> call = Rf_lang2( Rf_install("stop"), cond );
+            Shield<SEXP> call = Rf_lang2( RCPP_SYMBOL("stop"), cond );
             Rf_eval( call, R_GlobalEnv ) ;        
         }
         
@@ -46,12 +46,12 @@ namespace Rcpp {
         
         inline operator SEXP(){
             // form simple error condition based on a string
-            Shield<SEXP> simpleErrorExpr = ::Rf_lang2(::Rf_install("simpleError"), Rf_mkString(str.c_str()));
+            Shield<SEXP> simpleErrorExpr = ::Rf_lang2(RCPP_SYMBOL("simpleError"), Rf_mkString(str.c_str()));
             Shield<SEXP> simpleError = Rf_eval(simpleErrorExpr, R_GlobalEnv);
     
             Shield<SEXP> tryError = Rf_mkString( str.c_str() ) ;
             Rf_setAttrib( tryError, R_ClassSymbol, Rf_mkString("try-error") ) ; 
-            Rf_setAttrib( tryError, Rf_install( "condition") , simpleError ) ; 
+            Rf_setAttrib( tryError, RCPP_SYMBOL("condition") , simpleError ) ; 
             return tryError;
         }
     private:
@@ -5,16 +5,18 @@
 
 namespace Rcpp {
 
+#if !defined(RCPP11_EVAL_UNWIND_PROTECT)
     inline SEXP Rcpp_eval(SEXP expr, SEXP env ){
         // version not using contexts for windows until we figure out how to
-        Shield<SEXP> x = Rf_lang3( Rf_install("try"), expr, Rf_ScalarLogical(TRUE) );
-        SET_TAG( CDDR(x), Rf_install("silent") );
+        Shield<SEXP> x = Rf_lang3( RCPP_SYMBOL("try"), expr, Rf_ScalarLogical(TRUE) );
+        SET_TAG( CDDR(x), RCPP_SYMBOL("silent") );
         Shield<SEXP> res = Rf_eval( x, env) ;
         if( inherits( res, "try-error" ) ){
             stop( CHAR(STRING_ELT(res, 0)) ) ;
         }
         return res ;
     }
+#endif
     inline SEXP get_current_call() { return R_NilValue; }
 }
     #else
@@ -106,7 +108,7 @@ namespace Rcpp{
                 R_FalseValue
             ) ;
 
-            SEXP symb = Rf_install(".addCondHands") ;
+            SEXP symb = RCPP_SYMBOL(".addCondHands") ;
             SEXP ifun = INTERNAL( symb ) ;
             PRIMFUN(ifun)(symb, ifun, args, R_GlobalEnv );
 
@@ -139,12 +141,13 @@ namespace Rcpp{
           if( Rf_isNull(condition) ){
               stop("eval error : %s", R_curErrorBuf()) ;
           } else {
-              Shield<SEXP> msg = Rf_eval( Rf_lang2( Rf_install( "conditionMessage"),  condition ), R_GlobalEnv ) ;
+              Shield<SEXP> msg = Rf_eval( Rf_lang2( RCPP_SYMBOL("conditionMessage"),  condition ), R_GlobalEnv ) ;
               stop("eval error : %s", CHAR(STRING_ELT(msg, 0)) ) ;
           }
         }
     }
 
+#if !defined(RCPP11_EVAL_UNWIND_PROTECT)
     inline SEXP Rcpp_eval(SEXP expr, SEXP env ){
         SEXP res ;
         try_catch( [&](){
@@ -152,7 +155,71 @@ namespace Rcpp{
         }) ;
         return res ;
     }
+#endif
+
+
+}
+
+#endif
+
+#if defined(RCPP11_UNWIND_PROTECT)
 
+namespace Rcpp{
+
+    namespace internal{
+
+        struct EvalData {
+            SEXP expr ;
+            SEXP env ;
+        } ;
+
+        inline SEXP unwind_protect_eval( void* data ){
+            EvalData* eval_data = reinterpret_cast<EvalData*>(data) ;
+            return Rf_eval( eval_data->expr, eval_data->env ) ;
+        }
+
+        inline void unwind_protect_cleanup( void* jmpbuf, Rboolean jump ){
+            if( jump ) std::longjmp( *reinterpret_cast<std::jmp_buf*>(jmpbuf), 1 ) ;
+        }
+
+    }
+
+    // Evaluates expr in env with no R level error handling, about as cheap
+    // as Rf_eval. A long jump out of the evaluation (error, interrupt,
+    // restart, ...) is intercepted by R_UnwindProtect and becomes a
+    // LongjumpException, so that the C++ frames are unwound. The END_RCPP
+    // macros then resume the jump, so that R handles the condition as if
+    // no C++ code was involved.
+    //
+    // Unlike Rcpp_eval, R errors are not turned into Rcpp::exception: R
+    // has already reported them, and code that catches the
+    // LongjumpException must rethrow it
+    inline SEXP Rcpp_fast_eval( SEXP expr, SEXP env ){
+        internal::EvalData data = { expr, env } ;
+        Shield<SEXP> protected_expr( expr ) ;
+        Shield<SEXP> token = R_MakeUnwindCont() ;
+        std::jmp_buf jmpbuf ;
+        if( setjmp(jmpbuf) ){
+            throw internal::LongjumpException( token ) ;
+        }
+        return R_UnwindProtect( internal::unwind_protect_eval, &data, internal::unwind_protect_cleanup, &jmpbuf, token ) ;
+    }
+
+#if defined(RCPP11_EVAL_UNWIND_PROTECT)
+    inline SEXP Rcpp_eval( SEXP expr, SEXP env ){
+        return Rcpp_fast_eval( expr, env ) ;
+    }
+#endif
+
+}
+
+#else
+
+namespace Rcpp{
+
+    inline SEXP Rcpp_fast_eval( SEXP expr, SEXP env ){
+        return Rcpp_eval( expr, env ) ;
+    }
 
 }
 
@@ -118,14 +118,17 @@ namespace Rcpp{
         inline R_xlen_t size() const { return length() ; }
         
         R_xlen_t offset(const std::string& name) const {
-            SEXP names = RCPP_GET_NAMES(data) ;
-            R_xlen_t n = size() ;
-        
-            SEXP* data = internal::r_vector_start<STRSXP>(names) ;
-            R_xlen_t index = std::find( data, data+n, Rf_mkChar(name.c_str()) ) - data ;
-            if( index == n ) stop("no such column name '%s'", name) ;
+            R_xlen_t index = internal::find_name( RCPP_GET_NAMES(data), name ) ;
+            if( index < 0 ) stop("no such column name '%s'", name) ;
             return index ;
         }
+        
+        IntegerVector offsets(const CharacterVector& targets) const {
+            IntegerVector res( targets.size() ) ;
+            R_xlen_t missing = internal::find_names( data, targets, res.begin() ) ;
+            if( missing >= 0 ) stop("no such column name '%s'", CHAR(STRING_ELT(targets, missing)) ) ;
+            return res ;
+        }
     
         class NameProxy {
         public:
@@ -143,6 +146,8 @@ namespace Rcpp{
                 try{
                     index = parent.offset(name) ;
                     parent[ index ] = rhs ;
+                } catch( internal::LongjumpException& ){
+                    throw ;
                 } catch( ... ){
                     List v(parent) ;
                     v[name] = rhs ;
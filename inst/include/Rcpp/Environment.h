@@ -11,7 +11,7 @@ namespace Rcpp{
         
         inline SEXP as_environment(SEXP x){  
             if( Rf_isEnvironment(x) ) return x ;
-            return Rcpp_eval( Rf_lang2( Rf_install("as.environment"), x ) );
+            return Rcpp_eval( Rf_lang2( RCPP_SYMBOL("as.environment"), x ) );
         }
     
     public:
@@ -31,8 +31,10 @@ namespace Rcpp{
             } else{
                 SEXP res = R_NilValue ;
                 try{
-                    SEXP asEnvironmentSym = Rf_install("as.environment"); 
+                    SEXP asEnvironmentSym = RCPP_SYMBOL("as.environment"); 
                     res = Rcpp_eval(Rf_lang2( asEnvironmentSym, Rf_mkString(name.c_str()) ) ) ;
+                } catch( internal::LongjumpException& ){
+                    throw ;
                 } catch( ... ){
                     stop("no such environment '%s'", name ) ;
                 }
@@ -42,8 +44,10 @@ namespace Rcpp{
         
         Environment_Impl( int pos ) {
             try{
-                SEXP asEnvironmentSym = Rf_install("as.environment"); 
+                SEXP asEnvironmentSym = RCPP_SYMBOL("as.environment"); 
                 data = Rcpp_eval( Rf_lang2( asEnvironmentSym, Rf_ScalarInteger(pos) ) ) ;
+            } catch( internal::LongjumpException& ){
+                throw ;
             } catch( ... ){
                 stop( "no such environment '%d'", pos );
             }    
@@ -117,8 +121,8 @@ namespace Rcpp{
                 } else{
                     /* unless we want to copy all of do_remove, 
                        we have to go back to R to do this operation */
-                    SEXP internalSym = Rf_install( ".Internal" );
-                    SEXP removeSym = Rf_install( "remove" );
+                    SEXP internalSym = RCPP_SYMBOL(".Internal");
+                    SEXP removeSym = RCPP_SYMBOL("remove");
                     Shield<SEXP> call = Rf_lang2(
                         internalSym, 
                         Rf_lang4(removeSym, Rf_mkString(name.c_str()), data, R_FalseValue) 
@@ -206,8 +210,10 @@ namespace Rcpp{
         static Environment_Impl namespace_env(const std::string& package) {
             SEXP env = R_NilValue ;
             try{
-                SEXP getNamespaceSym = Rf_install("getNamespace");
+                SEXP getNamespaceSym = RCPP_SYMBOL("getNamespace");
                 env = Rcpp_eval( Rf_lang2(getNamespaceSym, Rf_mkString(package.c_str()) ) ) ;
+            } catch( internal::LongjumpException& ){
+                throw ;
             } catch( ... ){
                 stop("no such namespace : '%s' ", package);
             }
@@ -225,7 +231,7 @@ namespace Rcpp{
          * creates a new environment whose this is the parent
          */
         Environment_Impl new_child(bool hashed) {
-            SEXP newEnvSym = Rf_install("new.env");
+            SEXP newEnvSym = RCPP_SYMBOL("new.env");
             return Environment( Rcpp_eval(Rf_lang3( newEnvSym, Rf_ScalarLogical(hashed), data )) );    
         }
         
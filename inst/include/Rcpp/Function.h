@@ -41,6 +41,17 @@ namespace Rcpp{
             return Rcpp_eval(call) ;
         }
         
+        /**
+         * same as operator(), but evaluated with Rcpp_fast_eval: an R error
+         * unwinds as internal::LongjumpException that END_RCPP resumes, 
+         * instead of becoming an Rcpp::exception
+         */
+        template<typename... Args> 
+        SEXP fast_call( Args&&... args) const {
+            Shield<SEXP> call = language( data , std::forward<Args>(args)... ) ;
+            return Rcpp_fast_eval(call) ;
+        }
+        
         /**
          * Returns the environment of this function
          */
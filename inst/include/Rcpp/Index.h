@@ -18,27 +18,28 @@ namespace Rcpp{
             typename... Args, 
             typename = typename std::enable_if< ValidIndexArgs<N,Args...>() >::type 
         >
-        Index( Args... args ) : dimensions({{ static_cast<size_t>(args)... }}) {}
+        Index( Args... args ) : dimensions{{ static_cast<int>(args)... }} {}
+        
+        Index( const std::array<int,N>& dimensions_ ) : dimensions(dimensions_){}
         
         template < 
             typename... Args, 
             typename = typename std::enable_if< ValidIndexArgs<N,Args...>() >::type
         >
-        size_t operator()( Args... args){
+        size_t operator()( Args... args) const {
             return get_index( args... ) ;    
         }
     
-        inline size_t prod(){
-            return std::accumulate( dimensions.begin(), dimensions.end(), 1, std::multiplies<double>() ) ;     
+        inline R_xlen_t prod() const {
+            return std::accumulate( dimensions.begin(), dimensions.end(), static_cast<R_xlen_t>(1), std::multiplies<R_xlen_t>() ) ;     
         }
-        inline size_t size(){ 
+        inline size_t size() const { 
             return N ;
         }
         
         inline operator SEXP() const { return wrap( dimensions ); }
-        inline operator SEXP() { return wrap( dimensions ); }
         
-        inline size_t& operator[](int i){
+        inline int& operator[](int i){
             return dimensions[i] ;
         }
         
@@ -50,17 +51,21 @@ namespace Rcpp{
             return dimensions[i] ;    
         }
         
-    private:
+        inline const std::array<int,N>& dims() const {
+            return dimensions ;    
+        }
         
         template <typename... Args >
-        size_t get_index( size_t first, Args... args){
+        size_t get_index( size_t first, Args... args) const {
             return first + dimensions[ N - sizeof...(Args) - 1 ] * get_index( args... );
         }
         
-        size_t get_index( size_t first ){
+        size_t get_index( size_t first ) const {
             return first ;
         }
         
+    private:
+        
         std::array<int,N> dimensions ;
         
     } ;
@@ -66,6 +66,18 @@ namespace Rcpp{
             return Rcpp_eval( data, env ) ;
         }
 
+        /**
+         * eval this call with Rcpp_fast_eval: no condition handlers, an R
+         * error unwinds as internal::LongjumpException that END_RCPP resumes
+         */
+        SEXP fast_eval() const {
+            return fast_eval( R_GlobalEnv ) ;
+        }
+
+        SEXP fast_eval(SEXP env) const {
+            return Rcpp_fast_eval( data, env ) ;
+        }
+
     };
     
     
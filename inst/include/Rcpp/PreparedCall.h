@@ -0,0 +1,126 @@
+#ifndef Rcpp_PreparedCall_h
+#define Rcpp_PreparedCall_h
+
+namespace Rcpp{
+
+    /**
+     * Call to a function that is allocated once and evaluated many times.
+     *
+     * The arguments of the call are slots that are rebound in place, so
+     * repeated calls do not allocate a new call, only the wrapped arguments.
+     *
+     *     PreparedCall call( f, 2 ) ;        // f(<slot>, <slot>)
+     *     for( ... ) call( x, y ) ;
+     *
+     * Named or fixed arguments are set up by preparing a Language object:
+     *
+     *     PreparedCall call( Language( f, _["x"] = 0.0, _["tol"] = 1e-8 ) ) ;
+     *     call.set( 0, x ) ;                  // only rebinds x
+     *     call.eval() ;
+     *
+     * eval and operator() go through Rcpp_eval, so an R error becomes an
+     * Rcpp::exception. fast_eval and fast_call go through Rcpp_fast_eval
+     * instead, which saves the condition handlers of every evaluation:
+     *
+     *     for( ... ) call.fast_call( x, y ) ;
+     *
+     * With these an R error (or interrupt) unwinds the C++ frames as an
+     * internal::LongjumpException, which must be left to reach END_RCPP
+     * (rethrow it from catch(...) blocks) so that R gets the original
+     * condition back.
+     */
+    class PreparedCall {
+    public:
+
+        /**
+         * call to the function with nargs positional argument slots,
+         * initially NULL
+         */
+        PreparedCall( const Function& fun, int nargs ) :
+            call( Rf_lcons( fun, Rf_allocList(nargs) ) ), slots()
+        {
+            init() ;
+        }
+
+        /**
+         * the arguments of the call are the slots, in order
+         */
+        explicit PreparedCall( const Language& call_ ) :
+            call( Rf_duplicate(call_) ), slots()
+        {
+            init() ;
+        }
+
+        inline int size() const { return slots.size() ; }
+
+        /**
+         * rebinds the i-th argument (0 based)
+         */
+        template <typename T>
+        inline void set( int i, const T& value ){
+            SETCAR( slots[i], wrap(value) ) ;
+        }
+
+        /**
+         * rebinds the first arguments and evaluates the call
+         */
+        template <typename... Args>
+        inline SEXP operator()( const Args&... args ){
+            bind( args... ) ;
+            return eval() ;
+        }
+
+        /**
+         * same as operator(), evaluating with fast_eval
+         */
+        template <typename... Args>
+        inline SEXP fast_call( const Args&... args ){
+            bind( args... ) ;
+            return fast_eval() ;
+        }
+
+        inline SEXP eval() const {
+            return call.eval() ;
+        }
+
+        inline SEXP eval( SEXP env ) const {
+            return call.eval( env ) ;
+        }
+
+        /**
+         * evaluates the call with Rcpp_fast_eval, R errors are
+         * internal::LongjumpException
+         */
+        inline SEXP fast_eval() const {
+            return call.fast_eval() ;
+        }
+
+        inline SEXP fast_eval( SEXP env ) const {
+            return call.fast_eval( env ) ;
+        }
+
+        inline operator SEXP() const { return call ; }
+
+    private:
+
+        template <typename... Args>
+        inline void bind( const Args&... args ){
+            if( sizeof...(Args) > slots.size() ) stop( "too many arguments: %d, the call has %d slots", sizeof...(Args), slots.size() ) ;
+            int i = 0 ;
+            std::initializer_list<int>{ ( set( i++, args ), 0 )... } ;
+        }
+
+        // the cells of the arguments, so that set is O(1)
+        void init(){
+            for( SEXP node = CDR(call); !Rf_isNull(node); node = CDR(node) ){
+                slots.push_back( node ) ;
+            }
+        }
+
+        Language call ;
+        std::vector<SEXP> slots ;
+    } ;
+
+} // namespace Rcpp
+
+#endif
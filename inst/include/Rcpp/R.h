@@ -23,6 +23,23 @@ extern "C" {
 #include <R_ext/Callbacks.h>
 #include <Rversion.h>
 
+// R_UnwindProtect, used by Rcpp_fast_eval, is available since R 3.5.0.
+// Rcpp_eval also uses it when RCPP11_FAST_EVAL is defined
+#if R_VERSION >= R_Version(3, 5, 0) && !defined(RCPP11_NO_UNWIND_PROTECT)
+    #define RCPP11_UNWIND_PROTECT
+    #if defined(RCPP11_FAST_EVAL)
+        #define RCPP11_EVAL_UNWIND_PROTECT
+    #endif
+#endif
+
+#if defined(RCPP11_USE_BLAS)
+    #include <R_ext/BLAS.h>
+    #include <R_ext/Lapack.h>
+    #ifndef FCONE
+        #define FCONE
+    #endif
+#endif
+
 typedef SEXP (*CCODE)(SEXP, SEXP, SEXP, SEXP);
  
 /* Information for Deparsing Expressions */
@@ -0,0 +1,192 @@
+#ifndef Rcpp__SparseMatrix__h
+#define Rcpp__SparseMatrix__h
+
+namespace Rcpp{
+
+    // view of a "dgCMatrix" object from the Matrix package, a numeric sparse
+    // matrix in compressed sparse column format. The slots are used in place:
+    // column j holds the values x[k] at rows i[k] for k in [p[j],p[j+1]).
+    //
+    // A SparseMatrix is a matrix expression, so it converts to a dense matrix:
+    //
+    //     NumericMatrix dense = sp ;
+    //
+    // and a dense matrix converts back with SparseMatrix(dense)
+    class SparseMatrix :
+        public SugarMatrixExpression< double, SparseMatrix >,
+        public sugar::custom_sugar_matrix_expression
+    {
+    public:
+        typedef double value_type ;
+
+        // non zero element of a column
+        struct Entry {
+            int row ;
+            double value ;
+        } ;
+
+        class Column {
+        public:
+            class const_iterator {
+            public:
+                typedef std::random_access_iterator_tag iterator_category ;
+                typedef Entry value_type ;
+                typedef R_xlen_t difference_type ;
+                typedef const Entry* pointer ;
+                typedef Entry reference ;
+
+                const_iterator( const int* rows_, const double* values_ ) : rows(rows_), values(values_){}
+
+                inline Entry operator*() const { return Entry{ *rows, *values } ; }
+                inline const_iterator& operator++(){ ++rows ; ++values ; return *this ; }
+                inline const_iterator operator++(int){ const_iterator tmp(*this) ; ++(*this) ; return tmp ; }
+                inline const_iterator& operator+=( difference_type n ){ rows += n ; values += n ; return *this ; }
+                inline const_iterator operator+( difference_type n ) const { return const_iterator( rows + n, values + n ) ; }
+                inline difference_type operator-( const const_iterator& other ) const { return rows - other.rows ; }
+                inline Entry operator[]( difference_type n ) const { return Entry{ rows[n], values[n] } ; }
+                inline bool operator==( const const_iterator& other ) const { return rows == other.rows ; }
+                inline bool operator!=( const const_iterator& other ) const { return rows != other.rows ; }
+
+            private:
+                const int* rows ;
+                const double* values ;
+            } ;
+
+            Column( const int* rows_, const double* values_, int n_ ) : rows(rows_), values(values_), n(n_){}
+
+            inline int size() const { return n ; }
+            inline int row( int k ) const { return rows[k] ; }
+            inline double value( int k ) const { return values[k] ; }
+
+            inline const_iterator begin() const { return const_iterator( rows, values ) ; }
+            inline const_iterator end() const { return const_iterator( rows + n, values + n ) ; }
+
+        private:
+            const int* rows ;
+            const double* values ;
+            int n ;
+        } ;
+
+        SparseMatrix( SEXP x ) : object( check_object(x) ){
+            update() ;
+        }
+
+        // sparse copy of a dense matrix, keeping the elements that are not 0
+        explicit SparseMatrix( const NumericMatrix& dense ) : object("dgCMatrix") {
+            int n = dense.nrow(), p = dense.ncol() ;
+            const double* data = dense.begin() ;
+
+            IntegerVector col_ptr( p + 1 ) ;
+            int* pp = col_ptr.begin() ;
+            pp[0] = 0 ;
+            R_xlen_t grain = std::max<R_xlen_t>( 1, RCPP11_PARALLEL_MINIMUM_SIZE / std::max(n,1) ) ;
+            parallel_for( 0, p, grain, [=]( R_xlen_t begin, R_xlen_t end ){
+                for( R_xlen_t j=begin; j<end; j++){
+                    const double* col = data + j * n ;
+                    pp[j+1] = static_cast<int>( n - std::count( col, col + n, 0.0 ) ) ;
+                }
+            }) ;
+            for( int j=0; j<p; j++){
+                if( pp[j+1] > INT_MAX - pp[j] ) stop( "too many non zero elements" ) ;
+                pp[j+1] += pp[j] ;
+            }
+
+            IntegerVector rows( pp[p] ) ;
+            NumericVector values( pp[p] ) ;
+            int* pi = rows.begin() ;
+            double* px = values.begin() ;
+            parallel_for( 0, p, grain, [=]( R_xlen_t begin, R_xlen_t end ){
+                for( R_xlen_t j=begin; j<end; j++){
+                    const double* col = data + j * n ;
+                    int k = pp[j] ;
+                    for( int i=0; i<n; i++){
+                        if( col[i] == 0.0 ) continue ;
+                        pi[k] = i ;
+                        px[k] = col[i] ;
+                        k++ ;
+                    }
+                }
+            }) ;
+
+            slot_sym( object, RCPP_SYMBOL("i") ) = rows ;
+            slot_sym( object, RCPP_SYMBOL("p") ) = col_ptr ;
+            slot_sym( object, RCPP_SYMBOL("x") ) = values ;
+            slot_sym( object, RCPP_SYMBOL("Dim") ) = IntegerVector::create( n, p ) ;
+            SEXP dimnames = Rf_getAttrib( dense, R_DimNamesSymbol ) ;
+            if( !Rf_isNull(dimnames) ) slot_sym( object, RCPP_SYMBOL("Dimnames") ) = dimnames ;
+            update() ;
+        }
+
+        inline operator SEXP() const { return object ; }
+
+        inline int nrow() const { return nr ; }
+        inline int ncol() const { return nc ; }
+        inline R_xlen_t size() const { return static_cast<R_xlen_t>(nr) * nc ; }
+
+        // number of stored elements
+        inline int nnz() const { return col_ptr[nc] ; }
+
+        inline const int* row_indices() const { return row_index ; }
+        inline const int* column_pointers() const { return col_ptr ; }
+        inline const double* values() const { return x ; }
+
+        inline SEXP dimnames() const {
+            return R_do_slot( object, RCPP_SYMBOL("Dimnames") ) ;
+        }
+
+        inline Column column( int j ) const {
+            return Column( row_index + col_ptr[j], x + col_ptr[j], col_ptr[j+1] - col_ptr[j] ) ;
+        }
+
+        // binary search for the row in the column
+        inline double operator()( int i, int j ) const {
+            const int* first = row_index + col_ptr[j] ;
+            const int* last = row_index + col_ptr[j+1] ;
+            const int* it = std::lower_bound( first, last, i ) ;
+            return ( it != last && *it == i ) ? x[ it - row_index ] : 0.0 ;
+        }
+
+        // dense copy, in parallel over the columns
+        template <typename Target>
+        void apply( Target& target ) const {
+            auto out = target.begin() ;
+            const int *pi = row_index, *pp = col_ptr ;
+            const double* px = x ;
+            int n = nr ;
+            R_xlen_t grain = std::max<R_xlen_t>( 1, RCPP11_PARALLEL_MINIMUM_SIZE / std::max(n,1) ) ;
+            parallel_for( 0, nc, grain, [=]( R_xlen_t begin, R_xlen_t end ){
+                for( R_xlen_t j=begin; j<end; j++){
+                    auto col = out + j * n ;
+                    std::fill( col, col + n, 0.0 ) ;
+                    for( int k=pp[j]; k<pp[j+1]; k++) col[ pi[k] ] = px[k] ;
+                }
+            }) ;
+        }
+
+    private:
+
+        static SEXP check_object( SEXP x ){
+            if( !Rf_isS4(x) || !Rf_inherits(x, "dgCMatrix") )
+                stop( "not a dgCMatrix object" ) ;
+            return x ;
+        }
+
+        void update(){
+            SEXP dim = R_do_slot( object, RCPP_SYMBOL("Dim") ) ;
+            nr = INTEGER(dim)[0] ;
+            nc = INTEGER(dim)[1] ;
+            row_index = INTEGER( R_do_slot( object, RCPP_SYMBOL("i") ) ) ;
+            col_ptr = INTEGER( R_do_slot( object, RCPP_SYMBOL("p") ) ) ;
+            x = REAL( R_do_slot( object, RCPP_SYMBOL("x") ) ) ;
+        }
+
+        S4 object ;
+        const int* row_index ;
+        const int* col_ptr ;
+        const double* x ;
+        int nr, nc ;
+    } ;
+
+}
+
+#endif
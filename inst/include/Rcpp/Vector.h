@@ -13,6 +13,7 @@
 #include <Rcpp/vector/generic_proxy.h>
 
 #include <Rcpp/vector/VectorOfRTYPE.h>
+#include <Rcpp/vector/NameIndex.h>
 #include <Rcpp/vector/impl/SimpleVector.h>
 #include <Rcpp/vector/impl/LogicalVector.h>
 #include <Rcpp/vector/impl/CharacterVector.h>
@@ -32,6 +33,7 @@
 #include <Rcpp/vector/StrideIterator.h>
 #include <Rcpp/vector/MatrixColumn.h>
 #include <Rcpp/vector/MatrixRow.h>
+#include <Rcpp/vector/SubMatrix.h>
 #include <Rcpp/vector/Matrix.h>
 #include <Rcpp/vector/SquareMatrix.h>
 
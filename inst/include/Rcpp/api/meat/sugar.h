@@ -49,15 +49,70 @@ namespace Rcpp{
         
         
         // default applyer for when Expression does not know how to 
-        // apply itself to Target
+        // apply itself to Target. 
+        //
+        // The columns are split in blocks of whole columns, so that each thread 
+        // writes a contiguous part of the target. Expressions backed by 
+        // column major storage (i.e. matrices) are copied column by column. 
+        // Elements that are R objects are always processed on the calling thread
         template <typename Target, typename eT, typename Expr>
         struct sugar_matrix_expression_op {
+            typedef typename Target::value_type target_type ;
+            typedef typename std::integral_constant<bool, 
+                ( traits::is_primitive<eT>::value || std::is_same<eT,Rboolean>::value ) && 
+                ( traits::is_primitive<target_type>::value || std::is_same<target_type,Rboolean>::value )
+            >::type parallel_safe ;
+            typedef typename traits::has_iterator<Expr>::type dense ;
+            
             inline void apply( Target& target, const SugarMatrixExpression<eT,Expr>& expr ){
-                int nc = target.ncol(), nr = target.nrow() ;
-                auto it = target.begin() ;
-                for( int j=0; j<nc; j++) 
+                apply_parallel( target, expr ) ;
+            }
+            
+            inline void apply_serial( Target& target, const SugarMatrixExpression<eT,Expr>& expr ){
+                fill_columns( target.begin(), expr.get_ref(), target.nrow(), 0, target.ncol(), dense() ) ;
+            }
+            
+            inline void apply_parallel( Target& target, const SugarMatrixExpression<eT,Expr>& expr ){
+                apply_parallel_impl( target, expr, parallel_safe() ) ;
+            }
+            
+        private:
+            
+            inline void apply_parallel_impl( Target& target, const SugarMatrixExpression<eT,Expr>& expr, std::false_type ){
+                apply_serial( target, expr ) ;
+            }
+            
+            void apply_parallel_impl( Target& target, const SugarMatrixExpression<eT,Expr>& expr, std::true_type ){
+                int nr = target.nrow(), nc = target.ncol() ;
+                if( nr == 0 || static_cast<R_xlen_t>(nr) * nc <= RCPP11_PARALLEL_MINIMUM_SIZE ){
+                    apply_serial( target, expr ) ;
+                    return ;
+                }
+                
+                // enough columns per block to amortize the scheduling
+                R_xlen_t grain = std::max<R_xlen_t>( 1, RCPP11_PARALLEL_BLOCK_SIZE / nr ) ;
+                int nthreads = parallel::number_of_threads( nc, grain ) ;
+                
+                auto out = target.begin() ;
+                const Expr& ref = expr.get_ref() ;
+                parallel::run_chunks( nc, nthreads, grain, [out,&ref,nr]( int, R_xlen_t begin, R_xlen_t end ){
+                    fill_columns( out, ref, nr, begin, end, dense() ) ;
+                }) ;
+            }
+            
+            // fills the columns [begin,end) of the target
+            template <typename OutputIterator>
+            static inline void fill_columns( OutputIterator out, const Expr& ref, int nr, R_xlen_t begin, R_xlen_t end, std::true_type ){
+                auto source = ref.begin() ;
+                std::copy( source + begin * nr, source + end * nr, out + begin * nr ) ;
+            }
+            
+            template <typename OutputIterator>
+            static inline void fill_columns( OutputIterator out, const Expr& ref, int nr, R_xlen_t begin, R_xlen_t end, std::false_type ){
+                auto it = out + begin * nr ;
+                for( R_xlen_t j=begin; j<end; j++) 
                     for( int i=0; i<nr; i++, ++it) 
-                        *it = expr(i,j) ;
+                        *it = ref(i,j) ;
             }
         } ;
     }
@@ -98,6 +153,25 @@ namespace Rcpp{
             sugar::sugar_matrix_expression_op<Target,eT,Expr>().apply( target, *this ) ;  
     }
     
+    // custom matrix expressions only implement apply
+    template <typename eT, typename Expr>
+    template <typename Target>
+    void SugarMatrixExpression<eT,Expr>::apply_serial( Target& target ) const {
+        if( std::is_base_of<sugar::custom_sugar_matrix_expression, Expr>::value )
+            get_ref().apply(target) ;
+        else 
+            sugar::sugar_matrix_expression_op<Target,eT,Expr>().apply_serial( target, *this ) ;  
+    }
+    
+    template <typename eT, typename Expr>
+    template <typename Target>
+    void SugarMatrixExpression<eT,Expr>::apply_parallel( Target& target ) const {
+        if( std::is_base_of<sugar::custom_sugar_matrix_expression, Expr>::value )
+            get_ref().apply(target) ;
+        else 
+            sugar::sugar_matrix_expression_op<Target,eT,Expr>().apply_parallel( target, *this ) ;  
+    }
+    
     
 }
 
@@ -24,9 +24,12 @@ namespace Rcpp{
     
         /* iterating */
         
+        // atomic vectors are coerced element by element straight into the
+        // destination, without an intermediate R vector of the target type
         template <typename InputIterator, typename value_type>
-            void export_range__impl( SEXP x, InputIterator first, std::false_type ) {
+        void export_range__impl( SEXP x, InputIterator first, std::false_type ) {
             const int RTYPE = ::Rcpp::traits::r_sexptype_traits<value_type>::rtype ;
+            if( ::Rcpp::internal::coerce_atomic<RTYPE>( x, first, no_cast() ) ) return ;
             typedef typename ::Rcpp::traits::storage_type<RTYPE>::type STORAGE ;
             Shield<SEXP> y = ::Rcpp::r_cast<RTYPE>(x) ;
             STORAGE* start = ::Rcpp::internal::r_vector_start<RTYPE>(y) ;
@@ -37,6 +40,7 @@ namespace Rcpp{
         void export_range__impl( SEXP x, InputIterator first, std::true_type ) {
             const int RTYPE = ::Rcpp::traits::r_sexptype_traits<value_type>::rtype ;
             typedef typename ::Rcpp::traits::storage_type<RTYPE>::type STORAGE ;
+            if( ::Rcpp::internal::coerce_atomic<RTYPE>( x, first, caster_function<STORAGE,value_type>() ) ) return ;
             Shield<SEXP> y = ::Rcpp::r_cast<RTYPE>(x) ;
             STORAGE* start = ::Rcpp::internal::r_vector_start<RTYPE>(y) ;
             std::transform( start, start + ::Rf_xlength(y) , first, caster<STORAGE,value_type> ) ;
@@ -6,6 +6,8 @@
     #include <execinfo.h>
 #endif
 
+#include <atomic>
+
 namespace Rcpp{
 
     inline std::string demangle( const std::string& name ){
@@ -22,35 +24,70 @@ namespace Rcpp{
         return real_class ;
     }
 
+    // whether exceptions record the call stack when they are constructed.
+    // The frames are only symbolised when the message is used, but 
+    // recording them still walks the stack
+    inline std::atomic<bool>& exception_backtrace_flag(){
+        static std::atomic<bool> flag( RCPP11_EXCEPTION_BACKTRACE ) ;
+        return flag ;
+    }
+    
+    inline bool exception_backtrace(){
+        return exception_backtrace_flag() ;
+    }
+    
+    // turns the recording on or off, returns the previous setting
+    inline bool exception_backtrace( bool enabled ){
+        return exception_backtrace_flag().exchange( enabled ) ;
+    }
+    
     class exception : public std::exception {
     public:
         explicit exception(const char* message_) : message(message_) {
-            add_backtrace_information(message);
+            record_backtrace();
         }
         explicit exception(std::string  message_) : message(std::move(message_)) {
-            add_backtrace_information(message);
+            record_backtrace();
         }
         exception(const char* message_, const char* file, int line ): message(message_) {
-            add_backtrace_information(message);
+            record_backtrace();
         }
         virtual ~exception() noexcept {}
-        virtual const char* what() const noexcept /* override */ { return message.c_str() ; }
+        
+        // the message, followed by the traceback when one was recorded
+        virtual const char* what() const noexcept /* override */ { 
+            if( stack.empty() ) return message.c_str() ;
+            if( full_message.empty() ){
+                // no R code runs here, only allocations can fail
+                try{
+                    full_message = message + backtrace_information() ;
+                } catch( const std::bad_alloc& ){
+                    return message.c_str() ;
+                }
+            }
+            return full_message.c_str() ; 
+        }
     
     private:
         std::string message ;
+        std::vector<void*> stack ;
+        mutable std::string full_message ;
     
-        // A private function for adding backtrace information if possible
+        // Private functions for adding backtrace information if possible
         #if ( defined(__GNUC__) || defined(__clang__) ) &&  !defined(_WIN32)
-        void add_backtrace_information(std::string& message) {
+        void record_backtrace(){
+          if( !exception_backtrace() ) return ;
           const size_t max_depth = 100;
-          size_t stack_depth;
           void *stack_addrs[max_depth];
-          char **stack_strings;
-    
-          stack_depth = backtrace(stack_addrs, max_depth);
-          stack_strings = backtrace_symbols(stack_addrs, stack_depth);
-          std::vector<std::string> demangled;
-          demangled.reserve(stack_depth);
+          size_t stack_depth = backtrace(stack_addrs, max_depth);
+          if( stack_depth > 2 ) stack.assign( stack_addrs, stack_addrs + stack_depth ) ;
+        }
+        
+        std::string backtrace_information() const {
+          size_t stack_depth = stack.size() ;
+          char **stack_strings = backtrace_symbols(stack.data(), stack_depth);
+          if( !stack_strings ) return std::string() ;
+          std::string res = "\n\nTraceback (most recent call first):\n";
     
           // demangle the lines and add back in
           for (size_t i=0; i < stack_depth-2; ++i) {
@@ -70,26 +107,67 @@ namespace Rcpp{
             ) ;
             to_add += Rcpp::demangle(buffer);
             to_add += std::string( buffer2.begin() + demangle_end, buffer2.end() );
-            demangled.emplace_back(to_add);
-          }
-    
-          message += "\n\nTraceback (most recent call first):\n";
-    
-          for (size_t i=0; i < stack_depth-2; ++i) {
-            message += demangled[i];
-            message += "\n";
+            res += to_add;
+            res += "\n";
           }
     
           free(stack_strings); // malloc()ed by backtrace_symbols
+          return res ;
         }
         #else
         // No-op if we can't add backtrace information
-        void add_backtrace_information(std::string& message) {
+        void record_backtrace() {
           // do nothing
         }
+        std::string backtrace_information() const {
+          return std::string() ;
+        }
         #endif
     } ;
 
+    namespace internal{
+
+        // Sentinel for an R long jump (error, interrupt, restart, ...) that was
+        // intercepted by Rcpp_fast_eval, so that the C++ frames are unwound
+        // before the jump is resumed by the END_RCPP macros. R has already
+        // handled the condition (e.g. printed the error), so code that
+        // catches it must rethrow it. The continuation token is released
+        // when the last copy of the exception is destroyed or when the jump
+        // is resumed
+        class LongjumpException : public std::exception {
+        public:
+            explicit LongjumpException( SEXP token_ ) :
+                token( token_, []( SEXP x ){ R_ReleaseObject(x) ; } )
+            {
+                R_PreserveObject(token_) ;
+            }
+
+            virtual const char* what() const noexcept {
+                return "long jump out of R code (error, interrupt or restart)" ;
+            }
+
+            // gives up the protection of the token, which is returned
+            inline SEXP release(){
+                SEXP res = token.get() ;
+                token.reset() ;
+                return res ;
+            }
+
+        private:
+            std::shared_ptr<SEXPREC> token ;
+        } ;
+
+        inline void resume_jump( LongjumpException& ex ){
+            SEXP token = ex.release() ;
+        #if defined(RCPP11_UNWIND_PROTECT)
+            R_ContinueUnwind(token) ;
+        #else
+            (void)token ;
+        #endif
+        }
+
+    }
+
     template <typename... Args>
     inline void stop(const char* fmt, Args&&... args) {
         throw Rcpp::exception( tfm::format(fmt, std::forward<Args>(args)...).c_str() );
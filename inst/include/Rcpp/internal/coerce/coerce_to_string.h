@@ -3,75 +3,140 @@
 
 namespace Rcpp{
 namespace internal{
-     
-    inline int integer_width( int n ){
-        return n < 0 ? ( (int) ( ::log10( -n+0.5) + 2 ) ) : ( (int) ( ::log10( n+0.5) + 1 ) ) ;    
+
+    // writes the digits of n at the end of the range that finishes at end,
+    // returns the first digit
+    inline char* write_digits_backwards( unsigned long long n, char* end ){
+        do {
+            *--end = static_cast<char>( '0' + n % 10 ) ;
+            n /= 10 ;
+        } while( n ) ;
+        return end ;
     }
 
-    #define NB 1000
-    template <> inline const char* coerce_to_string<INTSXP>(int from){
-        static char buffer[NB] ;
-        snprintf( buffer, NB, "%*d", integer_width(from), from );
+    template <> inline const char* coerce_to_string<INTSXP>(int from, char* buffer){
+        char digits[16] ;
+        char* end = digits + sizeof(digits) ;
+        unsigned long long n = from < 0 ? -static_cast<long long>(from) : from ;
+        char* start = write_digits_backwards( n, end ) ;
+        char* out = buffer ;
+        if( from < 0 ) *out++ = '-' ;
+        out = std::copy( start, end, out ) ;
+        *out = '\0' ;
         return buffer ;
     }
-    template <> inline const char* coerce_to_string<LGLSXP>(Rboolean from){
-        return from == 0 ? "FALSE" : "TRUE" ;    
+    template <> inline const char* coerce_to_string<LGLSXP>(Rboolean from, char*){
+        return from == 0 ? "FALSE" : "TRUE" ;
     }
-    template <> inline const char* coerce_to_string<RAWSXP>(Rbyte from){
-        static char buff[3];
-        snprintf(buff, 3, "%02x", from);
-        return buff ;    
+    template <> inline const char* coerce_to_string<RAWSXP>(Rbyte from, char* buffer){
+        const char* hex = "0123456789abcdef" ;
+        buffer[0] = hex[ from >> 4 ] ;
+        buffer[1] = hex[ from & 15 ] ;
+        buffer[2] = '\0' ;
+        return buffer ;
     }
-        
-    template <typename charT>
-    const charT* dropTrailing0(charT *s, charT cdec) {
-        /* Note that  's'  is modified */
-        charT *p = s;
-        for (p = s; *p; p++) {
-            if(*p == cdec) {
-                charT *replace = p++;
-                while ('0' <= *p  &&  *p <= '9') if(*(p++) != '0') replace = p;
-                if(replace != p) while((*(replace++) = *(p++))) ;
-                break;
+
+    // as.character for a double, cf formatReal and EncodeReal in R's
+    // src/main/format.c and src/main/printutils.c: the number is shown with
+    // the fewest significant digits (at most 15) that give the same value
+    // at 15 digits, in fixed notation unless scientific notation is
+    // narrower
+    inline bool use_fixed_notation( bool neg, int nsig, int kpower ){
+        int rgt = std::max( 0, nsig - kpower - 1 ) ;
+        int left = kpower >= 0 ? kpower + 1 : 1 ;
+        int fixed_width = neg + left + ( rgt > 0 ? rgt + 1 : 0 ) ;
+        int sci_width = neg + ( nsig > 1 ? nsig + 1 : 1 ) + ( std::abs(kpower) >= 100 ? 5 : 4 ) ;
+        return fixed_width <= sci_width ;
+    }
+
+    // writes m / 10^decimals, where m has at most 15 digits and decimals
+    // is at most 15
+    inline const char* format_decimal( bool neg, unsigned long long m, int decimals, char* buffer ){
+        char digits[24] ;
+        char* end = digits + sizeof(digits) ;
+        char* start = write_digits_backwards( m, end ) ;
+        int kpower = static_cast<int>( end - start ) - 1 - decimals ;
+        char* last = end ;
+        while( last - start > 1 && last[-1] == '0' ) last-- ;
+        int nsig = static_cast<int>( last - start ) ;
+
+        char* out = buffer ;
+        if( neg ) *out++ = '-' ;
+        if( use_fixed_notation( neg, nsig, kpower ) ){
+            if( kpower >= 0 ){
+                out = std::copy( start, start + kpower + 1, out ) ;
+                start += kpower + 1 ;
+            } else {
+                *out++ = '0' ;
+            }
+            // m may have more decimals than needed, they are 0
+            if( start < last ){
+                *out++ = '.' ;
+                for( int i=kpower+1; i<0; i++) *out++ = '0' ;
+                out = std::copy( start, last, out ) ;
+            }
+        } else {
+            *out++ = *start ;
+            if( nsig > 1 ){
+                *out++ = '.' ;
+                out = std::copy( start + 1, last, out ) ;
             }
+            *out++ = 'e' ;
+            *out++ = kpower < 0 ? '-' : '+' ;
+            int e = std::abs( kpower ) ;
+            if( e >= 100 ) *out++ = static_cast<char>( '0' + e / 100 ) ;
+            *out++ = static_cast<char>( '0' + e / 10 % 10 ) ;
+            *out++ = static_cast<char>( '0' + e % 10 ) ;
         }
-        return s;
+        *out = '\0' ;
+        return buffer ;
     }
-    
-    template <> inline const char* coerce_to_string<REALSXP>(double x){
-        //int w,d,e ;
-        // cf src/main/format.c in R's sources:
-        //   The return values are
-        //     w : the required field width
-        //     d : use %w.df in fixed format, %#w.de in scientific format
-        //     e : use scientific format if != 0, value is number of exp digits - 1
-        //
-        //   nsmall specifies the minimum number of decimal digits in fixed format:
-        //   it is 0 except when called from do_format.
-        //Rf_formatReal( &x, 1, &w, &d, &e, 0 ) ;
-        // we are no longer allowed to use this:
-        //     char* tmp = const_cast<char*>( Rf_EncodeReal(x, w, d, e, '.') );
-        // so approximate it poorly as
-        static char tmp[128];
-        snprintf(tmp, 127, "%f", x); 
-        return dropTrailing0(tmp, '.');
+
+    // When x * 10^d rounds to an integer m below 1e15 for some d <= 15, x is
+    // within half an ulp of m / 10^d, much closer than the spacing of 15
+    // digit decimals, so the digits of m are the significant digits of x.
+    // Other numbers go through snprintf on a local buffer, as R does
+    template <> inline const char* coerce_to_string<REALSXP>(double x, char* buffer){
+        if( std::isnan(x) ) return "NaN" ;
+        if( std::isinf(x) ) return x > 0 ? "Inf" : "-Inf" ;
+        if( x == 0.0 ) return "0" ;
+
+        bool neg = x < 0 ;
+        double ax = std::fabs(x), scale = 1.0 ;
+        for( int d=0; d<=15; d++, scale *= 10.0 ){
+            double y = ax * scale ;
+            if( y >= 1e15 ) break ;
+            if( y == std::floor(y) ) return format_decimal( neg, static_cast<unsigned long long>(y), d, buffer ) ;
+        }
+
+        // 15 significant digits: d.dddddddddddddde[+-]x..
+        char sci[32] ;
+        snprintf( sci, sizeof(sci), "%.14e", ax ) ;
+        char* e = strchr( sci, 'e' ) ;
+        int kpower = atoi( e + 1 ) ;
+        char* last = e ;
+        while( last[-1] == '0' ) last-- ;
+        if( last[-1] == '.' ) last-- ;
+        int nsig = last == sci + 1 ? 1 : static_cast<int>( last - sci ) - 1 ;
+
+        if( use_fixed_notation( neg, nsig, kpower ) ){
+            snprintf( buffer, coerce_buffer_size, "%.*f", std::max( 0, nsig - kpower - 1 ), x ) ;
+        } else {
+            snprintf( buffer, coerce_buffer_size, "%.*e", nsig - 1, x ) ;
+        }
+        return buffer ;
     }
-    
-    template <> inline const char* coerce_to_string<CPLXSXP>(Rcomplex x){
-        //int wr, dr, er, wi, di, ei;
-        //Rf_formatComplex(&x, 1, &wr, &dr, &er, &wi, &di, &ei, 0);
-        // we are no longer allowed to use this:
-        //     Rf_EncodeComplex(x, wr, dr, er, wi, di, ei, '.' );
-        // so approximate it poorly as
-        static char tmp1[128], tmp2[128], tmp3[256];
-        //snprintf(tmp, 127, "%*.*f+%*.*fi", wr, dr, x.r, wi, di, x.i);
-        //snprintf(tmp, 127, "%f+%fi", x.r, x.i); // FIXEM: barebones default formatting
-        snprintf(tmp1, 127, "%f", x.r); 
-        snprintf(tmp2, 127, "%f", x.i); 
-        snprintf(tmp3, 255, "%s+%si", dropTrailing0(tmp1, '.'), dropTrailing0(tmp2, '.'));
-        return tmp3;
+
+    template <> inline const char* coerce_to_string<CPLXSXP>(Rcomplex x, char* buffer){
+        // the parts are formatted separately, not with a common number of
+        // digits as print does
+        char re[coerce_buffer_size], im[coerce_buffer_size] ;
+        const char* re_string = coerce_to_string<REALSXP>( x.r, re ) ;
+        const char* im_string = coerce_to_string<REALSXP>( std::fabs(x.i), im ) ;
+        snprintf( buffer, coerce_buffer_size, "%s%s%si", re_string, ( x.i < 0 ? "-" : "+" ), im_string ) ;
+        return buffer ;
     }
-  
+
 }
 }
 
@@ -0,0 +1,128 @@
+#ifndef Rcpp__internal_coerce_vector_h
+#define Rcpp__internal_coerce_vector_h
+
+namespace Rcpp{
+namespace internal{
+
+    // function objects applied to the coerced values before they are
+    // stored, so that the kernels below inline them
+    struct no_cast {
+        template <typename T>
+        inline T operator()( T x ) const { return x ; }
+    } ;
+
+    template <typename FROM, typename TO>
+    struct caster_function {
+        inline TO operator()( FROM x ) const { return caster<FROM,TO>(x) ; }
+    } ;
+
+    // each chunk collects the flags of its warnings, they are combined
+    // once the chunk is done
+    template <int FROM, int TO, typename OutputIterator, typename Fun>
+    int coerce_range__impl( const typename traits::storage_type<FROM>::type* input, R_xlen_t n, OutputIterator out, Fun fun, std::true_type ){
+        std::atomic<int> warnings(0) ;
+        auto body = [=,&warnings]( R_xlen_t begin, R_xlen_t end ){
+            int warn = 0 ;
+            for( R_xlen_t i=begin; i<end; i++){
+                out[i] = fun( r_coerce<FROM,TO>( input[i] ) ) ;
+                warn |= coerce_warnings<FROM,TO>( input[i] ) ;
+            }
+            if( warn ) warnings.fetch_or( warn ) ;
+        } ;
+        if( n <= RCPP11_PARALLEL_MINIMUM_SIZE ){
+            body( 0, n ) ;
+        } else {
+            parallel::run( n, body ) ;
+        }
+        return warnings.load() ;
+    }
+
+    template <int FROM, int TO, typename OutputIterator, typename Fun>
+    int coerce_range__impl( const typename traits::storage_type<FROM>::type* input, R_xlen_t n, OutputIterator out, Fun fun, std::false_type ){
+        int warn = 0 ;
+        for( R_xlen_t i=0; i<n; i++, ++out){
+            *out = fun( r_coerce<FROM,TO>( input[i] ) ) ;
+            warn |= coerce_warnings<FROM,TO>( input[i] ) ;
+        }
+        return warn ;
+    }
+
+    // writes fun( r_coerce<FROM,TO>(input[i]) ) to out for i in [0,n), in
+    // one pass over the data. NA and NaN follow the rules of R's
+    // coerceVector, and the flags of the warnings it would give are
+    // returned (see coerce_warning). Random access outputs of more than
+    // RCPP11_PARALLEL_MINIMUM_SIZE elements are filled in parallel, so fun
+    // must not use the R API and TO cannot be STRSXP
+    template <int FROM, int TO, typename OutputIterator, typename Fun>
+    inline int coerce_range( const typename traits::storage_type<FROM>::type* input, R_xlen_t n, OutputIterator out, Fun fun ){
+        // outputs that write through a proxy, e.g. std::vector<bool>, may
+        // share memory between elements, they are filled serially
+        typedef std::iterator_traits<OutputIterator> output_traits ;
+        typedef std::integral_constant<bool,
+            std::is_base_of<std::random_access_iterator_tag, typename output_traits::iterator_category>::value &&
+            std::is_same<typename output_traits::reference, typename output_traits::value_type&>::value
+        > use_threads ;
+        return coerce_range__impl<FROM,TO>( input, n, out, fun, use_threads() ) ;
+    }
+
+    // coerces the atomic vector x to TO into out, false if x is not a
+    // logical, integer, numeric, complex or raw vector. The warnings R
+    // gives are given on the calling thread, once the data is coerced
+    template <int TO, typename OutputIterator, typename Fun>
+    bool coerce_atomic( SEXP x, OutputIterator out, Fun fun ){
+        R_xlen_t n = Rf_xlength(x) ;
+        int warnings = 0 ;
+        switch( TYPEOF(x) ){
+        case LGLSXP:  warnings = coerce_range<LGLSXP,TO>( r_vector_start<LGLSXP>(x), n, out, fun ) ; break ;
+        case INTSXP:  warnings = coerce_range<INTSXP,TO>( r_vector_start<INTSXP>(x), n, out, fun ) ; break ;
+        case REALSXP: warnings = coerce_range<REALSXP,TO>( r_vector_start<REALSXP>(x), n, out, fun ) ; break ;
+        case CPLXSXP: warnings = coerce_range<CPLXSXP,TO>( r_vector_start<CPLXSXP>(x), n, out, fun ) ; break ;
+        case RAWSXP:  warnings = coerce_range<RAWSXP,TO>( r_vector_start<RAWSXP>(x), n, out, fun ) ; break ;
+        default: return false ;
+        }
+        coerce_warning( warnings ) ;
+        return true ;
+    }
+
+    // new vector of type TO with the values of the atomic vector x and its
+    // attributes, as Rf_coerceVector gives
+    template <int TO>
+    SEXP coerce_vector( SEXP x ){
+        Shield<SEXP> res = Rf_allocVector( TO, Rf_xlength(x) ) ;
+        coerce_atomic<TO>( x, r_vector_start<TO>(res), no_cast() ) ;
+        DUPLICATE_ATTRIB( res, x ) ;
+        return res ;
+    }
+
+    // CHARSXP elements are made on the calling thread, one at a time, and
+    // stored through the write barrier
+    template <int FROM>
+    SEXP coerce_to_strings__impl( SEXP x ){
+        R_xlen_t n = Rf_xlength(x) ;
+        Shield<SEXP> res = Rf_allocVector( STRSXP, n ) ;
+        const typename traits::storage_type<FROM>::type* input = r_vector_start<FROM>(x) ;
+        for( R_xlen_t i=0; i<n; i++){
+            SET_STRING_ELT( res, i, r_coerce<FROM,STRSXP>( input[i] ) ) ;
+        }
+        return res ;
+    }
+
+    // as.character for an atomic vector that has no class: the
+    // representations R gives, without the attributes
+    inline SEXP coerce_to_strings( SEXP x ){
+        switch( TYPEOF(x) ){
+        case LGLSXP:  return coerce_to_strings__impl<LGLSXP>(x) ;
+        case INTSXP:  return coerce_to_strings__impl<INTSXP>(x) ;
+        case REALSXP: return coerce_to_strings__impl<REALSXP>(x) ;
+        case CPLXSXP: return coerce_to_strings__impl<CPLXSXP>(x) ;
+        case RAWSXP:  return coerce_to_strings__impl<RAWSXP>(x) ;
+        default: break ;
+        }
+        stop( "not compatible with STRSXP" ) ;
+        return R_NilValue ; /* -Wall */
+    }
+
+}
+}
+
+#endif
@@ -14,15 +14,13 @@ namespace Rcpp{
         template <> inline int r_coerce<LGLSXP,INTSXP>(Rboolean from){
             return (from==NA_VALUE) ? NA_INTEGER : from ;
         }
+        // NA, NaN and values out of the int range give NA, as in R
         template <> inline int r_coerce<REALSXP,INTSXP>(double from){
-            if (Rcpp::internal::is_NaN(from)) return NA_INTEGER;
-            else if (from > INT_MAX || from <= INT_MIN ) {
-                return NA_INTEGER;
-            }
+            if( std::isnan(from) || from >= INT_MAX + 1. || from <= INT_MIN ) return NA_INTEGER ;
             return static_cast<int>(from);
-        
         }
         template <> inline int r_coerce<CPLXSXP,INTSXP>(Rcomplex from){
+            if( std::isnan(from.i) ) return NA_INTEGER ;
             return r_coerce<REALSXP,INTSXP>(from.r) ;
         }
         template <> inline int r_coerce<RAWSXP,INTSXP>(Rbyte from){
@@ -37,7 +35,7 @@ namespace Rcpp{
             return from == NA_INTEGER ? NA_REAL : static_cast<double>(from) ; 
         }
         template <> inline double r_coerce<CPLXSXP,REALSXP>(Rcomplex from){
-            return from.r ;
+            return std::isnan(from.r) || std::isnan(from.i) ? NA_REAL : from.r ;
         }
         template <> inline double r_coerce<RAWSXP,REALSXP>(Rbyte from){
             return static_cast<double>(from) ;
@@ -45,15 +43,14 @@ namespace Rcpp{
         
         // -> LGLSXP
         template <> inline Rboolean r_coerce<REALSXP,LGLSXP>(double from){
-            return ( from == NA_REAL ) ? NA_VALUE : ( from==0.0 ? FALSE : TRUE ) ;
+            return std::isnan(from) ? NA_VALUE : ( from==0.0 ? FALSE : TRUE ) ;
         }
         template <> inline Rboolean r_coerce<INTSXP,LGLSXP>(int from){
             return ( from == NA_INTEGER ) ? NA_VALUE : ( from == 0 ? FALSE : TRUE );
         }
         template <> inline Rboolean r_coerce<CPLXSXP,LGLSXP>(Rcomplex from){
-            if( from.r == NA_REAL ) return NA_VALUE ;
-            if( from.r == 0.0 || from.i == 0.0 ) return FALSE ;
-            return TRUE ;
+            if( std::isnan(from.r) || std::isnan(from.i) ) return NA_VALUE ;
+            return ( from.r != 0.0 || from.i != 0.0 ) ? TRUE : FALSE ;
         }
         template <> inline Rboolean r_coerce<RAWSXP,LGLSXP>(Rbyte from){
             if( from != static_cast<Rbyte>(0) ) return TRUE ;
@@ -61,15 +58,15 @@ namespace Rcpp{
         }
         
         // -> RAWSXP
-        template <> inline Rbyte r_coerce<REALSXP,RAWSXP>(double from){
-            if( from == NA_REAL) return static_cast<Rbyte>(0) ; 
-            return r_coerce<INTSXP,RAWSXP>(static_cast<int>(from)) ;
-        }
+        // through int, NA and values out of [0,255] give 0
         template <> inline Rbyte r_coerce<INTSXP,RAWSXP>(int from){
             return (from < 0 || from > 255) ? static_cast<Rbyte>(0) : static_cast<Rbyte>(from) ;
         }
+        template <> inline Rbyte r_coerce<REALSXP,RAWSXP>(double from){
+            return r_coerce<INTSXP,RAWSXP>( r_coerce<REALSXP,INTSXP>(from) ) ;
+        }
         template <> inline Rbyte r_coerce<CPLXSXP,RAWSXP>(Rcomplex from){
-            return r_coerce<REALSXP,RAWSXP>(from.r) ;
+            return r_coerce<INTSXP,RAWSXP>( r_coerce<CPLXSXP,INTSXP>(from) ) ;
         }
         template <> inline Rbyte r_coerce<LGLSXP,RAWSXP>(Rboolean from){
             return static_cast<Rbyte>(from == TRUE) ;
@@ -77,11 +74,7 @@ namespace Rcpp{
         
         // -> CPLXSXP
         template <> inline Rcomplex r_coerce<REALSXP,CPLXSXP>(double from){
-            if( from == NA_REAL ){
-                return Rcomplex{ NA_REAL, NA_REAL };
-            } else{
-                return Rcomplex{ from, 0.0 };
-            }
+            return Rcomplex{ from, 0.0 };
         }
         template <> inline Rcomplex r_coerce<INTSXP,CPLXSXP>(int from){
             if( from == NA_INTEGER ){
@@ -101,6 +94,54 @@ namespace Rcpp{
             }
             return Rcomplex{ NA_REAL, NA_REAL } ;
         }
+        
+        // the warnings Rf_coerceVector gives, as flags
+        enum coerce_warning {
+            COERCE_WARN_INT_NA = 1,
+            COERCE_WARN_IMAG   = 2,
+            COERCE_WARN_RAW    = 4
+        } ;
+        
+        // flags of the warnings R gives when it coerces the value, so that
+        // the kernels can collect them and warn once, on the calling thread
+        template <int FROM, int TO>
+        inline int coerce_warnings( typename ::Rcpp::traits::storage_type<FROM>::type ){
+            return 0 ;
+        }
+        
+        template <> inline int coerce_warnings<REALSXP,INTSXP>(double from){
+            return !std::isnan(from) && r_coerce<REALSXP,INTSXP>(from) == NA_INTEGER ? COERCE_WARN_INT_NA : 0 ;
+        }
+        template <> inline int coerce_warnings<CPLXSXP,INTSXP>(Rcomplex from){
+            if( std::isnan(from.r) || std::isnan(from.i) ) return 0 ;
+            if( r_coerce<REALSXP,INTSXP>(from.r) == NA_INTEGER ) return COERCE_WARN_INT_NA ;
+            return from.i != 0.0 ? COERCE_WARN_IMAG : 0 ;
+        }
+        template <> inline int coerce_warnings<CPLXSXP,REALSXP>(Rcomplex from){
+            if( std::isnan(from.r) || std::isnan(from.i) ) return 0 ;
+            return from.i != 0.0 ? COERCE_WARN_IMAG : 0 ;
+        }
+        
+        // NA is out of range too
+        template <> inline int coerce_warnings<INTSXP,RAWSXP>(int from){
+            return (from < 0 || from > 255) ? COERCE_WARN_RAW : 0 ;
+        }
+        template <> inline int coerce_warnings<REALSXP,RAWSXP>(double from){
+            return coerce_warnings<REALSXP,INTSXP>(from) | coerce_warnings<INTSXP,RAWSXP>( r_coerce<REALSXP,INTSXP>(from) ) ;
+        }
+        template <> inline int coerce_warnings<CPLXSXP,RAWSXP>(Rcomplex from){
+            return coerce_warnings<CPLXSXP,INTSXP>(from) | coerce_warnings<INTSXP,RAWSXP>( r_coerce<CPLXSXP,INTSXP>(from) ) ;
+        }
+        template <> inline int coerce_warnings<LGLSXP,RAWSXP>(Rboolean from){
+            return from == NA_VALUE ? COERCE_WARN_RAW : 0 ;
+        }
+        
+        // the warnings, with the messages of R
+        inline void coerce_warning( int warnings ){
+            if( warnings & COERCE_WARN_INT_NA ) Rf_warning( "NAs introduced by coercion to integer range" ) ;
+            if( warnings & COERCE_WARN_IMAG ) Rf_warning( "imaginary parts discarded in coercion" ) ;
+            if( warnings & COERCE_WARN_RAW ) Rf_warning( "out-of-range values treated as 0 in coercion to raw" ) ;
+        }
     
     }
 }
@@ -10,7 +10,7 @@ namespace internal{
         case RAWSXP:
         case LGLSXP:
         case CPLXSXP:
-            return Rf_coerceVector( x, INTSXP) ;
+            return coerce_vector<INTSXP>( x ) ;
         default:
             stop( "not compatible with INTSXP" ) ;
         }
@@ -23,7 +23,7 @@ namespace internal{
         case LGLSXP:
         case CPLXSXP:
         case RAWSXP:
-            return Rf_coerceVector( x, REALSXP );
+            return coerce_vector<REALSXP>( x ) ;
         default:
             stop( "not compatible with REALSXP" ) ;
         }
@@ -36,7 +36,7 @@ namespace internal{
         case INTSXP:
         case CPLXSXP:
         case RAWSXP:
-            return Rf_coerceVector( x, LGLSXP );
+            return coerce_vector<LGLSXP>( x ) ;
         default:
             stop( "not compatible with LGLSXP" ) ;
         }
@@ -49,7 +49,7 @@ namespace internal{
         case REALSXP:
         case INTSXP:
         case CPLXSXP:
-            return Rf_coerceVector( x, RAWSXP );
+            return coerce_vector<RAWSXP>( x ) ;
         default:
             stop( "not compatible with RAWSXP" ) ;
         }
@@ -63,7 +63,7 @@ namespace internal{
         case LGLSXP:
         case REALSXP:
         case INTSXP:
-            return Rf_coerceVector( x, CPLXSXP );
+            return coerce_vector<CPLXSXP>( x ) ;
         default:
             stop( "not compatible with CPLXSXP" ) ;
         }
@@ -78,9 +78,10 @@ namespace internal{
         case REALSXP:
         case INTSXP:
             {
-                // return Rf_coerceVector( x, STRSXP );
-                // coerceVector does not work for some reason
-                Shield<SEXP> call = Rf_lang2( Rf_install( "as.character" ), x ) ;
+                // classed vectors (factors, dates, ...) dispatch to their
+                // as.character method
+                if( !OBJECT(x) ) return coerce_to_strings( x ) ;
+                Shield<SEXP> call = Rf_lang2( RCPP_SYMBOL("as.character"), x ) ;
                 Shield<SEXP> res  = Rf_eval( call, R_GlobalEnv ) ;
                 return res ;
             }
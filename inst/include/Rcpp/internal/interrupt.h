@@ -40,6 +40,48 @@ namespace Rcpp {
             throw internal::InterruptedException();
     }
 
+    // Cheap interrupt checking for long running loops. Calling the checker 
+    // only decrements a counter, the clock is read every `stride` calls and 
+    // checkUserInterrupt is only invoked when at least `interval` has elapsed 
+    // since the last check. Must be used on the main R thread. 
+    //
+    //     InterruptChecker check_interrupt ;
+    //     for( R_xlen_t i=0; i<n; i++){
+    //         check_interrupt() ;
+    //         ...
+    //     }
+    class InterruptChecker {
+    public:
+        typedef std::chrono::steady_clock clock ;
+        
+        InterruptChecker( 
+            std::chrono::milliseconds interval_ = std::chrono::milliseconds(RCPP11_INTERRUPT_CHECK_INTERVAL), 
+            int stride_ = 1024 
+        ) : 
+            interval(interval_), stride(stride_), countdown(stride_), last(clock::now())
+        {}
+        
+        inline void operator()(){
+            if( --countdown <= 0 ) poll() ;
+        }
+        
+        // reads the clock and checks for interrupts if the interval has elapsed
+        inline void poll(){
+            countdown = stride ;
+            clock::time_point now = clock::now() ;
+            if( now - last >= interval ){
+                last = now ;
+                checkUserInterrupt() ;
+            }
+        }
+        
+    private:
+        clock::duration interval ;
+        int stride ;
+        int countdown ;
+        clock::time_point last ;
+    } ;
+
 } // namespace Rcpp
 
 #endif
@@ -45,28 +45,39 @@ namespace Rcpp{
         template <> Rcomplex r_coerce<LGLSXP,CPLXSXP>(Rboolean from) ;
         
         // -> STRSXP
+        // the representation is written to buffer (or is a literal), which
+        // must hold coerce_buffer_size characters
+        const int coerce_buffer_size = 64 ;
+        
         template <int RTYPE> 
-        const char* coerce_to_string( typename ::Rcpp::traits::storage_type<RTYPE>::type from ) ;
-        template <> const char* coerce_to_string<CPLXSXP>(Rcomplex from) ;
-        template <> const char* coerce_to_string<REALSXP>(double from) ; 
-        template <> const char* coerce_to_string<INTSXP >(int from) ;
-        template <> const char* coerce_to_string<RAWSXP >(Rbyte from) ;
-        template <> const char* coerce_to_string<LGLSXP >(Rboolean from) ;
+        const char* coerce_to_string( typename ::Rcpp::traits::storage_type<RTYPE>::type from, char* buffer ) ;
+        template <> const char* coerce_to_string<CPLXSXP>(Rcomplex from, char* buffer) ;
+        template <> const char* coerce_to_string<REALSXP>(double from, char* buffer) ; 
+        template <> const char* coerce_to_string<INTSXP >(int from, char* buffer) ;
+        template <> const char* coerce_to_string<RAWSXP >(Rbyte from, char* buffer) ;
+        template <> const char* coerce_to_string<LGLSXP >(Rboolean from, char* buffer) ;
+        
+        template <int RTYPE>
+        inline SEXP make_string( typename ::Rcpp::traits::storage_type<RTYPE>::type from ){
+            char buffer[coerce_buffer_size] ;
+            return Rf_mkChar( coerce_to_string<RTYPE>( from, buffer ) ) ;
+        }
         
         template <> inline SEXP r_coerce<STRSXP ,STRSXP>(SEXP from){ return from ; }
-        template <> inline SEXP r_coerce<CPLXSXP,STRSXP>(Rcomplex from) { return Rcpp::traits::is_na<CPLXSXP>(from) ? NA_STRING : Rf_mkChar( coerce_to_string<CPLXSXP>( from ) ) ; }
-        template <> inline SEXP r_coerce<REALSXP,STRSXP>(double from){ return Rcpp::traits::is_na<REALSXP>(from) ? NA_STRING :Rf_mkChar( coerce_to_string<REALSXP>( from ) ) ; }
-        template <> inline SEXP r_coerce<INTSXP ,STRSXP>(int from){ return Rcpp::traits::is_na<INTSXP>(from) ? NA_STRING :Rf_mkChar( coerce_to_string<INTSXP>( from ) ) ; }
-        template <> inline SEXP r_coerce<RAWSXP ,STRSXP>(Rbyte from){ return Rf_mkChar( coerce_to_string<RAWSXP>(from)); }
+        template <> inline SEXP r_coerce<CPLXSXP,STRSXP>(Rcomplex from) { return Rcpp::traits::is_na<CPLXSXP>(from) ? NA_STRING : make_string<CPLXSXP>( from ) ; }
+        template <> inline SEXP r_coerce<REALSXP,STRSXP>(double from){ return Rcpp::traits::is_na<REALSXP>(from) ? NA_STRING : make_string<REALSXP>( from ) ; }
+        template <> inline SEXP r_coerce<INTSXP ,STRSXP>(int from){ return Rcpp::traits::is_na<INTSXP>(from) ? NA_STRING : make_string<INTSXP>( from ) ; }
+        template <> inline SEXP r_coerce<RAWSXP ,STRSXP>(Rbyte from){ return make_string<RAWSXP>(from); }
         template <> inline SEXP r_coerce<LGLSXP ,STRSXP>(Rboolean from){ 
-            return Rcpp::traits::is_na<LGLSXP>(from) ? NA_STRING : Rf_mkChar( coerce_to_string<LGLSXP>(from));
+            return Rcpp::traits::is_na<LGLSXP>(from) ? NA_STRING : make_string<LGLSXP>(from);
         }
     
     } // internal
 } // Rcpp
 
 #include <Rcpp/internal/coerce/coerce_to_string.h>
-#include <Rcpp/internal/coerce/true_cast.h>
 #include <Rcpp/internal/coerce/r_coerce.h>
+#include <Rcpp/internal/coerce/coerce_vector.h>
+#include <Rcpp/internal/coerce/true_cast.h>
 
 #endif
@@ -37,6 +37,12 @@ public:                                                               \
     inline const AttributeProxy<__CLASS__> attr( const std::string& name ) const { \
         return Rcpp::attr(*this, name);                               \
     }                                                                 \
+    inline AttributeProxy<__CLASS__> attr_sym( SEXP symbol ){         \
+        return Rcpp::attr_sym(*this, symbol);                         \
+    }                                                                 \
+    inline const AttributeProxy<__CLASS__> attr_sym( SEXP symbol ) const { \
+        return Rcpp::attr_sym(*this, symbol);                         \
+    }                                                                 \
     
 #endif    
 
@@ -3,6 +3,10 @@
 
 #define RCPP_GET_NAMES(x) Rf_getAttrib(x, R_NamesSymbol)
 
+// symbol for a string literal, installed the first time the expression is
+// evaluated and cached afterwards. Symbols are never collected by R
+#define RCPP_SYMBOL(__NAME__) ( [](){ static SEXP sym = Rf_install(__NAME__) ; return sym ; }() )
+
 #ifndef BEGIN_RCPP
 #define BEGIN_RCPP try {
 #endif
@@ -10,6 +14,9 @@
 #ifndef VOID_END_RCPP
 #define VOID_END_RCPP                                    \
   }                                                      \
+  catch (Rcpp::internal::LongjumpException& __ex__) {    \
+    Rcpp::internal::resume_jump(__ex__);                 \
+  }                                                      \
   catch (Rcpp::internal::InterruptedException& __ex__) { \
     Rf_onintr();                                         \
   }                                                      \
@@ -28,6 +35,9 @@
 #ifndef END_RCPP_RETURN_ERROR
 #define END_RCPP_RETURN_ERROR                                           \
   }                                                                     \
+  catch (Rcpp::internal::LongjumpException& __ex__) {                   \
+    Rcpp::internal::resume_jump(__ex__);                                \
+  }                                                                     \
   catch (Rcpp::internal::InterruptedException& __ex__) {                \
     return Rcpp::internal::interruptedError();                          \
   }                                                                     \
@@ -50,6 +50,19 @@ namespace Rcpp{
     const AttributeProxy<CLASS> attr( const CLASS& obj, const std::string& name) {
         return AttributeProxy<CLASS>( const_cast<CLASS&>(obj) , Rf_install(name.c_str()) ) ;  
     }
+    
+    // same with the symbol of the attribute, e.g. R_DimSymbol or 
+    // RCPP_SYMBOL("tsp"), which saves the lookup of the name. A distinct 
+    // name, so that attr(x, cv[0]) or attr(x, String) still mean a name
+    template <typename CLASS>    
+    AttributeProxy<CLASS> attr_sym( CLASS& obj, SEXP symbol ) {
+        return AttributeProxy<CLASS>( obj, symbol ) ;
+    }
+    
+    template <typename CLASS>    
+    const AttributeProxy<CLASS> attr_sym( const CLASS& obj, SEXP symbol ) {
+        return AttributeProxy<CLASS>( const_cast<CLASS&>(obj), symbol ) ;  
+    }
           
     inline bool has_attr( SEXP data, const std::string& attr) {
         SEXP attrs = ATTRIB(data);
@@ -62,5 +75,12 @@ namespace Rcpp{
         return false;    
     }
     
+    inline bool has_attr_sym( SEXP data, SEXP symbol ) {
+        for( SEXP attrs = ATTRIB(data); attrs != R_NilValue; attrs = CDR(attrs) ){
+            if( TAG(attrs) == symbol ) return true ;
+        }
+        return false ;
+    }
+    
 }
 #endif
@@ -2,57 +2,118 @@
 #define Rcpp_proxy_EnvironmentBinding_h
 
 namespace Rcpp{
-    
+
+    namespace internal{
+
+        // is there a binding of symbol in the frame of env
+        inline bool binding_exists( SEXP env, SEXP symbol ){
+        #if R_VERSION >= R_Version(4, 2, 0)
+            return R_existsVarInFrame( env, symbol ) ;
+        #else
+            return Rf_findVarInFrame3( env, symbol, FALSE ) != R_UnboundValue ;
+        #endif
+        }
+
+        // value of the binding of symbol in the frame of env, R_NilValue if
+        // there is no such binding. Active bindings call their function and
+        // promises are forced
+        inline SEXP binding_value( SEXP env, SEXP symbol ){
+            SEXP res = Rf_findVarInFrame( env, symbol ) ;
+            if( res == R_UnboundValue ) return R_NilValue ;
+
+            /* We need to evaluate if it is a promise */
+            if( TYPEOF(res) == PROMSXP){
+                res = Rf_eval( res, env ) ;
+            }
+            return res ;
+        }
+
+        // Rf_defineVar calls the function of active bindings, locked
+        // bindings and locked environments are checked first so that they
+        // give a C++ exception rather than an R error
+        inline void binding_assign( SEXP env, SEXP symbol, SEXP x, const std::string& name ){
+            if( binding_exists( env, symbol ) ){
+                if( R_BindingIsLocked( symbol, env ) )
+                    stop("binding is locked : %s", name) ;
+            } else if( R_EnvironmentIsLocked( env ) ){
+                stop("cannot add binding '%s' to a locked environment", name) ;
+            }
+            Rf_defineVar( symbol, x, env ) ;
+        }
+
+    }
+
+    /**
+     * Binding of a variable in an environment.
+     *
+     * The symbol of the variable is installed once, the first time the
+     * binding is used, so a binding kept around reads and writes the
+     * variable without going through the symbol table again:
+     *
+     *     Binding<Environment> x = env["x"] ;
+     *     for( int i=0; i<n; i++) x = as<double>(x) + 1.0 ;
+     *
+     * Active bindings call their function, locked bindings cannot be
+     * assigned, and assigning a variable that does not exist yet defines it
+     * unless the environment is locked.
+     */
     template <typename EnvironmentClass>
     class Binding : public GenericProxy<Binding<EnvironmentClass>> {
     public:
-        Binding( EnvironmentClass& env_, std::string  name_) : 
-            env(env_), name(std::move(name_)){}
-        
-        inline bool active() const { 
-            return env.bindingIsActive(name) ;    
+        Binding( EnvironmentClass& env_, std::string  name_) :
+            env(env_), name(std::move(name_)), symbol(R_NilValue){}
+
+        inline bool active() const {
+            return env.bindingIsActive(name) ;
         }
         inline bool locked() const {
-            return env.bindingIsLocked(name) ;    
+            return env.bindingIsLocked(name) ;
         }
         inline bool exists() const {
-            return env.exists(name) ;    
+            return env.exists(name) ;
         }
         void lock() {
-            env.lockBinding(name) ;    
+            env.lockBinding(name) ;
         }
         void unlock(){
-            env.unlockBinding(name) ;    
+            env.unlockBinding(name) ;
         }
         Binding& operator=(const Binding& rhs){
-            if( *this != rhs )
+            if( this != &rhs )
                 set( rhs.get() ) ;
             return *this ;
         }
-        
-        template <typename T> 
+
+        template <typename T>
         Binding& operator=(const T& rhs) {
             set( wrap(rhs) ) ;
             return *this ;
         }
-        
+
         template <typename T> operator T() const{
-            return as<T>( get() ) ;  
+            return as<T>( get() ) ;
         }
-        
+
     private:
-        
+
         SEXP get() const {
-            return env.get( name ) ;    
+            return internal::binding_value( env, install() ) ;
         }
-        
+
         void set( SEXP x){
-            env.assign(name, x ) ;     
+            internal::binding_assign( env, install(), x, name ) ;
+        }
+
+        // symbols are never collected, so it does not need protection
+        SEXP install() const {
+            if( symbol == R_NilValue ) symbol = Rf_install( name.c_str() ) ;
+            return symbol ;
         }
-        
+
         EnvironmentClass& env ;
         std::string name ;
+        mutable SEXP symbol ;
     } ;
-    
+
 }
 #endif
@@ -3,11 +3,87 @@
 
 namespace Rcpp{
     
+    namespace internal{
+
+        // environment holding the fields of a reference class object,
+        // R_NilValue for other objects
+        inline SEXP reference_environment( SEXP x ){
+            if( !Rf_isS4(x) || !Rf_inherits(x, "envRefClass") ) return R_NilValue ;
+            SEXP env = Rf_getAttrib( x, RCPP_SYMBOL(".xData") ) ;
+            return TYPEOF(env) == ENVSXP ? env : R_NilValue ;
+        }
+
+        // definition of the class of a reference class object, from the
+        // environment of the object, R_NilValue if it is not there
+        inline SEXP reference_class_def( SEXP env ){
+            SEXP def = Rf_findVarInFrame( env, RCPP_SYMBOL(".refClassDef") ) ;
+            return Rf_isS4(def) ? def : R_NilValue ;
+        }
+
+        // is the symbol one of the fields of the class, as opposed to its
+        // methods and other internal bindings
+        inline bool is_reference_field( SEXP def, SEXP symbol ){
+            SEXP fields = Rf_getAttrib( Rf_getAttrib( def, RCPP_SYMBOL("fieldClasses") ), R_NamesSymbol ) ;
+            if( TYPEOF(fields) != STRSXP ) return false ;
+            const char* target = CHAR(PRINTNAME(symbol)) ;
+            for( R_xlen_t i=0; i<XLENGTH(fields); i++){
+                if( !strcmp( CHAR(STRING_ELT(fields, i)), target ) ) return true ;
+            }
+            return false ;
+        }
+
+        typedef std::unordered_map<SEXP,bool> reference_method_cache ;
+
+        // does a class of the reference class object x, below envRefClass,
+        // define a method for the generic, e.g. a user defined $ or $<-.
+        // The answer is cached per class definition, which is kept alive so
+        // that it cannot be confused with another one, so methods are only
+        // looked up the first time a field of the class is used
+        inline bool overrides_reference_method( SEXP x, SEXP def, const char* generic, reference_method_cache& cache ){
+            auto it = cache.find( def ) ;
+            if( it != cache.end() ) return it->second ;
+
+            Shield<SEXP> methods = R_FindNamespace( Rf_mkString("methods") ) ;
+            Shield<SEXP> is_call = Rf_lang2( RCPP_SYMBOL("is"), x ) ;
+            Shield<SEXP> classes = Rcpp_eval( is_call, methods ) ;
+            Shield<SEXP> name = Rf_mkString( generic ) ;
+            bool res = false ;
+            for( R_xlen_t i=0; i<XLENGTH(classes) && !res; i++){
+                if( !strcmp( CHAR(STRING_ELT(classes, i)), "envRefClass" ) ) break ;
+                Shield<SEXP> cl = Rf_ScalarString( STRING_ELT(classes, i) ) ;
+                Shield<SEXP> call = Rf_lang3( RCPP_SYMBOL("existsMethod"), name, cl ) ;
+                res = Rf_asLogical( Rcpp_eval( call, methods ) ) == TRUE ;
+            }
+            cache.emplace( Rcpp_PreserveObject(def), res ) ;
+            return res ;
+        }
+
+        inline bool overrides_dollar( SEXP x, SEXP def ){
+            // never destroyed, R may be gone when static objects are
+            static reference_method_cache& cache = *new reference_method_cache ;
+            return overrides_reference_method( x, def, "$", cache ) ;
+        }
+
+        inline bool overrides_dollar_gets( SEXP x, SEXP def ){
+            static reference_method_cache& cache = *new reference_method_cache ;
+            return overrides_reference_method( x, def, "$<-", cache ) ;
+        }
+
+    }
+
+    // field of a reference class object. The fields live in the
+    // environment of the object, so they are read and written through
+    // their binding in that environment (calling the accessor function of
+    // fields defined as active bindings). Anything else, e.g. methods that
+    // have not been used yet, objects that are not reference class objects
+    // or classes that define their own $ or $<- methods, goes through $ and
+    // $<-. Whether a class defines these methods is only asked to R the
+    // first time one of its fields is read or written
     template <typename CLASS>
     class FieldProxy : GenericProxy<FieldProxy<CLASS>> {
     public:
         FieldProxy( CLASS& v, const std::string& name) : 
-            parent(v), field_name( Rf_mkChar(name.c_str())) {}
+            parent(v), field_name(name), symbol( Rf_install(name.c_str()) ) {}
         
         FieldProxy& operator=(const FieldProxy& rhs){
             set( rhs.get() ) ;
@@ -29,19 +105,44 @@ namespace Rcpp{
         
     private:
         CLASS& parent; 
-        SEXP field_name ;
+        std::string field_name ;
+        SEXP symbol ;
             
+        // the environment and the class definition are looked up on every
+        // use, they are attributes and bindings of the object, and the
+        // binding itself too: methods are installed the first time they
+        // are used, and variables may be removed
         SEXP get() const {
+            SEXP x = parent ;
+            SEXP env = internal::reference_environment(x) ;
+            if( env != R_NilValue ){
+                SEXP def = internal::reference_class_def(env) ;
+                if( def != R_NilValue && !internal::overrides_dollar( x, def ) && internal::binding_exists( env, symbol ) )
+                    return internal::binding_value( env, symbol ) ;
+            }
+            
+            Shield<SEXP> name = Rf_mkString( field_name.c_str() ) ;
             Shield<SEXP> call = Rf_lang3( 
                 R_DollarSymbol, 
                 parent, 
-                Rf_ScalarString(field_name)
+                name
             ) ;
             return Rcpp_eval( call ) ;    
         }
         void set(SEXP x ){
-            SEXP dollarGetsSym = Rf_install( "$<-");
-            Shield<SEXP> name = Rf_ScalarString( field_name ) ;
+            SEXP object = parent ;
+            SEXP env = internal::reference_environment(object) ;
+            if( env != R_NilValue ){
+                SEXP def = internal::reference_class_def(env) ;
+                if( def != R_NilValue && internal::is_reference_field( def, symbol ) && 
+                    !internal::overrides_dollar_gets( object, def ) && internal::binding_exists( env, symbol ) ){
+                    internal::binding_assign( env, symbol, x, field_name ) ;
+                    return ;
+                }
+            }
+            
+            SEXP dollarGetsSym = RCPP_SYMBOL("$<-");
+            Shield<SEXP> name = Rf_mkString( field_name.c_str() ) ;
             Shield<SEXP> call = Rf_lang4( 
                 dollarGetsSym,
                 parent, 
@@ -19,6 +19,8 @@ namespace Rcpp{
             try{
                 index = parent.offset(name) ;
                 parent[ index ] = rhs ;
+            } catch( internal::LongjumpException& ){
+                throw ;
             } catch( ... ){
                 int n = parent.size() ;
                 CLASS v( n + 1 ) ;
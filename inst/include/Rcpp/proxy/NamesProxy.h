@@ -39,7 +39,7 @@ namespace Rcpp{
                 Rf_setAttrib( y, R_NamesSymbol, x ) ;
             } else {
                 /* use the slower and more flexible version (callback to R) */
-                SEXP namesSym = Rf_install( "names<-" );
+                SEXP namesSym = RCPP_SYMBOL("names<-");
                 parent = Rcpp_eval(Rf_lang3( namesSym, parent, x )) ;
             }
         
@@ -56,9 +56,28 @@ namespace Rcpp{
         return SlotProxy<CLASS>( const_cast<CLASS&>(x) , Rf_install(name.c_str()) ) ; 
     }
     
+    // same with the symbol of the slot, e.g. slot_sym( x, RCPP_SYMBOL("Dim") ), 
+    // which saves the lookup of the name
+    template <typename CLASS>
+    SlotProxy<CLASS> slot_sym(CLASS& x, SEXP symbol) {
+        if( !Rf_isS4(x) ) stop("not an S4 object");
+        return SlotProxy<CLASS>(x, symbol ) ;
+    }
+    
+    template <typename CLASS>
+    const SlotProxy<CLASS> slot_sym(const CLASS& x, SEXP symbol) {
+        if( !Rf_isS4(x) ) stop("not an S4 object");
+        return SlotProxy<CLASS>( const_cast<CLASS&>(x) , symbol ) ; 
+    }
+    
     inline bool has_slot(SEXP data, const std::string& name) {
         if( !Rf_isS4(data) ) stop("not an S4 object");
-        return R_has_slot( data, Rf_mkString(name.c_str()) ) ;    
+        return R_has_slot( data, Rf_install(name.c_str()) ) ;    
+    }
+    
+    inline bool has_slot_sym(SEXP data, SEXP symbol) {
+        if( !Rf_isS4(data) ) stop("not an S4 object");
+        return R_has_slot( data, symbol ) ;    
     }
     
     inline bool isS4(SEXP data) { 
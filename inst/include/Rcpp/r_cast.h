@@ -9,6 +9,8 @@ namespace Rcpp{
             try{
                 SEXP funSym = Rf_install(fun);
                 res = Rcpp_eval( Rf_lang2( funSym, x ) ) ;
+            } catch( internal::LongjumpException& ){
+                throw ;
             } catch( ... ){
                 stop("could not convert using R function '%s' ", fun) ;
             }
@@ -33,6 +33,7 @@ namespace Rcpp{
         }
     }
     SEXP Rcpp_eval(SEXP expr, SEXP env = R_GlobalEnv) ;
+    SEXP Rcpp_fast_eval(SEXP expr, SEXP env = R_GlobalEnv) ;
 }
 
 #endif
@@ -19,6 +19,7 @@
 #include <Rcpp/sugar/functions/sapply.h>
 #include <Rcpp/sugar/functions/mapply.h>
 #include <Rcpp/sugar/functions/lapply.h>
+#include <Rcpp/sugar/functions/sapply_chunked.h>
 #include <Rcpp/sugar/functions/ifelse.h>
 #include <Rcpp/sugar/functions/pmax.h>
 #include <Rcpp/sugar/functions/clamp.h>
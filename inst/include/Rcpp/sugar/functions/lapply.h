@@ -16,12 +16,95 @@ namespace Rcpp{
             Function f ;
         } ;
         
+        // the elements are computed in parallel when neither the input nor 
+        // the result of the function are R objects
+        template <typename eT, typename Function>
+        struct parallel_lapply_strategy {
+            typedef typename std::result_of<Function(eT)>::type result_type ;
+            typedef typename std::decay<result_type>::type value_type ;
+            
+            const static bool r_input = !is_utf8_function<Function>::value && !traits::is_primitive<eT>::value ;
+            const static bool r_output = std::is_convertible<value_type,SEXP>::value ;
+            
+            typedef typename std::conditional< r_input || r_output, 
+                sapply_serial_tag, 
+                typename std::conditional< is_utf8_function<Function>::value, 
+                    sapply_utf8_parallel_tag, 
+                    sapply_parallel_tag
+                >::type
+            >::type type ;
+        } ;
+        
+        template <typename eT, typename Expr, typename Function, typename Staged>
+        inline void parallel_lapply_stage( const SugarVectorExpression<eT,Expr>& expr, Function fun, Staged& staged, R_xlen_t, sapply_serial_tag ){
+            std::transform( sugar_begin(expr), sugar_end(expr), staged.begin(), fun ) ;    
+        }
+        
+        // not gated by RCPP11_PARALLEL_MINIMUM_SIZE: a few calls to an 
+        // expensive function are worth the threads, grain decides
+        template <typename eT, typename Expr, typename Function, typename Staged>
+        inline void parallel_lapply_stage( const SugarVectorExpression<eT,Expr>& expr, Function fun, Staged& staged, R_xlen_t grain, sapply_parallel_tag ){
+            auto input = sugar_begin(expr) ;
+            auto out = staged.begin() ;
+            parallel_for( 0, expr.size(), grain, [=]( R_xlen_t begin, R_xlen_t end ) mutable {
+                std::transform( input + begin, input + end, out + begin, fun ) ;
+            }) ;    
+        }
+        
+        template <typename eT, typename Expr, typename Function, typename Staged>
+        inline void parallel_lapply_stage( const SugarVectorExpression<eT,Expr>& expr, Function fun, Staged& staged, R_xlen_t grain, sapply_utf8_parallel_tag ){
+            std::vector<const char*> inputs = utf8_inputs(expr.get_ref()) ;
+            auto f = fun.fun ;
+            const char* const* input = inputs.data() ;
+            auto out = staged.begin() ;
+            // as with String, the function sees "NA" for missing strings
+            parallel_for( 0, static_cast<R_xlen_t>(inputs.size()), grain, [=]( R_xlen_t begin, R_xlen_t end ){
+                for( R_xlen_t i=begin; i<end; i++){
+                    out[i] = f( input[i] ? input[i] : "NA" ) ;
+                }
+            }) ;    
+        }
+        
     } // sugar
     
     template <typename eT, typename Expr, typename Function >
     inline auto lapply( const SugarVectorExpression<eT,Expr>& t, Function fun ) -> decltype( sapply(t, sugar::Wrapper<eT,Function>(fun) ) ) {
         return sapply( t, sugar::Wrapper<eT,Function>(fun) );
     }
+    
+    // lapply for functions returning C++ values (std::vector, std::tuple, 
+    // structs with a wrap, ...). The function is called in parallel and its 
+    // results are kept until they are all computed, they are then 
+    // wrapped into the list in a single pass on the calling thread. 
+    //
+    // Functions taking a `const char*` or a `std::string` can be used 
+    // on character vectors. When the input or the result of the function 
+    // is an R object, everything happens on the calling thread. 
+    //
+    // The elements are processed in blocks of at least grain elements, 
+    // by default one element: unlike sugar, small inputs are processed 
+    // in parallel, for functions that are expensive. Use a larger grain 
+    // for cheap functions, e.g. 
+    //
+    //     List res = parallel_lapply( x, fun, 1000 ) ;
+    template <typename eT, typename Expr, typename Function>
+    List parallel_lapply( const SugarVectorExpression<eT,Expr>& t, Function fun, R_xlen_t grain = 1 ){
+        typedef typename sugar::sugar_dispatch_function_type<Function, eT>::type function_type ;
+        typedef typename sugar::parallel_lapply_strategy<eT, function_type> strategy ;
+        typedef typename strategy::value_type value_type ;
+        
+        R_xlen_t n = t.size() ;
+        std::vector< parallel::Partial<value_type> > staged(n) ;
+        sugar::parallel_lapply_stage( t, function_type(fun), staged, grain, typename strategy::type() ) ;
+        
+        List out(n) ;
+        for( R_xlen_t i=0; i<n; i++){
+            // the staged value is released as soon as it is wrapped
+            value_type value( std::move(staged[i].value) ) ;
+            out[i] = wrap( value ) ;
+        }
+        return out ;
+    }
 
 } // Rcpp
 
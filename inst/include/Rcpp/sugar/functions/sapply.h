@@ -43,6 +43,234 @@ namespace Rcpp{
             >::type type ;
         } ;
         
+        // adapts a function taking its string argument as a `const char*` or 
+        // a `std::string` so that it can be applied to the elements of a character 
+        // vector. Strings are passed UTF-8 encoded. 
+        template <typename Function>
+        struct utf8_function {
+            typedef typename std::result_of<Function(const char*)>::type result_type ;
+            
+            utf8_function( Function fun_ ) : fun(fun_){}
+            
+            inline result_type operator()( const String& x ) const {
+                return fun( x.get_cstring() ) ;
+            }
+            
+            Function fun ;
+        } ;
+        
+        template <typename Function>
+        struct is_utf8_function : std::false_type {} ;
+        
+        template <typename Function>
+        struct is_utf8_function< utf8_function<Function> > : std::true_type {} ;
+        
+        // functions that take strings without going through String are
+        // applied to character vectors through utf8_function
+        template <typename Function>
+        struct is_utf8_compatible : std::integral_constant<bool, 
+            !traits::is_callable<Function,String>::value && traits::is_callable<Function,const char*>::value 
+        >{} ;
+        
+        // How Sapply processes its elements in parallel. Threads must not use the 
+        // R API, so: 
+        //   - sapply_serial_tag        : R objects are needed for each element, 
+        //                                e.g. the function takes a String or returns 
+        //                                an R object. Everything happens on the 
+        //                                calling thread
+        //   - sapply_parallel_tag      : elements are read, computed and stored 
+        //                                by the threads
+        //   - sapply_strings_tag       : two phases. The threads compute 
+        //                                std::string results, which are then turned 
+        //                                into CHARSXP on the calling thread
+        // and the utf8 variants for when the input is a character vector and 
+        // the function takes `const char*` or `std::string` : the calling thread 
+        // first collects pointers to the UTF-8 strings. 
+        struct sapply_serial_tag{} ;
+        struct sapply_parallel_tag{} ;
+        struct sapply_strings_tag{} ;
+        struct sapply_utf8_parallel_tag{} ;
+        struct sapply_utf8_strings_tag{} ;
+        
+        template <typename eT, typename Function, typename value_type, int RTYPE>
+        struct sapply_strategy {
+            typedef typename std::decay<value_type>::type result_type ;
+            
+            const static bool utf8_input = is_utf8_function<Function>::value ;
+            const static bool r_input = !utf8_input && !traits::is_primitive<eT>::value ;
+            
+            const static bool string_result = 
+                std::is_same<result_type,std::string>::value || 
+                std::is_same<result_type,const char*>::value || 
+                std::is_same<result_type,char*>::value ;
+            const static bool r_output = ( RTYPE == STRSXP ) ? !string_result : 
+                ( RTYPE == VECSXP || RTYPE == EXPRSXP || !traits::is_primitive<result_type>::value ) ;
+            
+            typedef typename std::conditional< r_input || r_output, 
+                sapply_serial_tag, 
+                typename std::conditional< RTYPE == STRSXP, 
+                    typename std::conditional< utf8_input, sapply_utf8_strings_tag, sapply_strings_tag>::type, 
+                    typename std::conditional< utf8_input, sapply_utf8_parallel_tag, sapply_parallel_tag>::type
+                >::type
+            >::type type ;
+        } ;
+        
+        // result of the first phase of sapply_strings_tag
+        struct string_result {
+            string_result() : value(), na(true){}
+            string_result( std::string value_ ) : value(std::move(value_)), na(false){}
+            
+            std::string value ;
+            bool na ;
+        } ;
+        
+        inline string_result make_string_result( std::string x ){
+            return string_result( std::move(x) ) ;
+        }
+        inline string_result make_string_result( const char* x ){
+            return x ? string_result( x ) : string_result() ;
+        }
+        
+        template <typename T>
+        inline bool is_na_input( const T& x ){ return x == NA ; }
+        
+        inline bool is_na_input( const char* x ){ return x == nullptr ; }
+        
+        // same NA handling as function_wrapper_type: NA inputs give NA without 
+        // calling the function, except for double and bool inputs
+        template <typename Function, typename input_type>
+        struct string_result_wrapper {
+            const static bool test_na = !std::is_same<input_type,bool>::value && !std::is_same<input_type,double>::value ;
+            
+            string_result_wrapper( Function fun_ ) : fun(fun_){}
+            
+            inline string_result operator()( input_type x ) const {
+                if( test_na && is_na_input(x) ) return string_result() ;
+                return make_string_result( fun(x) ) ;
+            }
+            
+            Function fun ;
+        } ;
+        
+        template <typename Function, typename Target>
+        struct utf8_function_wrapper {
+            const static int RTYPE = Target::r_type::value ;
+            typedef typename traits::r_vector_element_converter<RTYPE>::type converter ;
+            typedef typename traits::storage_type<RTYPE>::type STORAGE ;
+            
+            utf8_function_wrapper( Function fun_ ) : fun(fun_){}
+            
+            inline STORAGE operator()( const char* x ) const {
+                return x ? converter::get(fun(x)) : (STORAGE)NA ;    
+            }
+            
+            Function fun; 
+        } ;
+        
+        // UTF-8 pointers to the strings of a character vector expression, 
+        // NA strings are null pointers. Uses the R API, so must be called on 
+        // the calling thread. The pointers remain valid until the end of the 
+        // .Call
+        template <typename Expr>
+        std::vector<const char*> utf8_inputs( const Expr& vec ){
+            R_xlen_t n = vec.size() ;
+            std::vector<const char*> inputs(n) ;
+            auto it = vec.begin() ;
+            for( R_xlen_t i=0; i<n; i++, ++it){
+                SEXP x = *it ;
+                inputs[i] = ( x == NA_STRING ) ? nullptr : Rf_translateCharUTF8(x) ;
+            }
+            return inputs ;
+        }
+        
+        // second phase of sapply_strings_tag, on the calling thread. Identical
+        // results are looked up in a local cache instead of going through 
+        // the global CHARSXP cache again, unless it turns out that results 
+        // are mostly distinct
+        template <typename Target>
+        void intern_strings( Target& target, std::vector<string_result>& results ){
+            struct Hash {
+                inline size_t operator()( const std::string* s ) const { return std::hash<std::string>()(*s) ; }
+            } ;
+            struct Equal {
+                inline bool operator()( const std::string* x, const std::string* y ) const { return *x == *y ; }
+            } ;
+            std::unordered_map<const std::string*, SEXP, Hash, Equal> cache ;
+            bool use_cache = true ;
+            R_xlen_t lookups = 0, hits = 0 ;
+            
+            R_xlen_t n = results.size() ;
+            auto it = target.begin() ;
+            for( R_xlen_t i=0; i<n; i++, ++it){
+                const string_result& res = results[i] ;
+                if( res.na ){
+                    *it = NA_STRING ;
+                    continue ;
+                }
+                SEXP x ;
+                if( use_cache ){
+                    auto found = cache.find( &res.value ) ;
+                    lookups++ ;
+                    if( found != cache.end() ){
+                        hits++ ;
+                        x = found->second ;
+                    } else {
+                        x = Rf_mkCharLenCE( res.value.data(), res.value.size(), CE_UTF8 ) ;
+                        cache.insert( std::make_pair( &res.value, x ) ) ;
+                    }
+                    if( lookups == 1024 && hits < 128 ){
+                        use_cache = false ;
+                        cache.clear() ;
+                    }
+                } else {
+                    x = Rf_mkCharLenCE( res.value.data(), res.value.size(), CE_UTF8 ) ;
+                }
+                // the CHARSXP is protected by target from now on
+                *it = x ;
+            }
+        }
+        
+        template <typename eT, typename Target, typename Expr, typename Function>
+        inline void sapply_apply_parallel( Target& target, const Expr& vec, const Function& fun, sapply_serial_tag ){
+            std::transform( vec.begin(), vec.end(), target.begin(), 
+                typename function_wrapper_type<Function, Target, eT>::type(fun)
+            );
+        }
+        
+        template <typename eT, typename Target, typename Expr, typename Function>
+        inline void sapply_apply_parallel( Target& target, const Expr& vec, const Function& fun, sapply_parallel_tag ){
+            parallel::transform( vec.begin(), vec.end(), target.begin(), 
+                typename function_wrapper_type<Function, Target, eT>::type(fun)
+            ) ;
+        }
+        
+        template <typename eT, typename Target, typename Expr, typename Function>
+        inline void sapply_apply_parallel( Target& target, const Expr& vec, const Function& fun, sapply_utf8_parallel_tag ){
+            std::vector<const char*> inputs = utf8_inputs(vec) ;
+            parallel::transform( inputs.begin(), inputs.end(), target.begin(), 
+                utf8_function_wrapper<decltype(fun.fun), Target>(fun.fun)
+            ) ;
+        }
+        
+        template <typename eT, typename Target, typename Expr, typename Function>
+        inline void sapply_apply_parallel( Target& target, const Expr& vec, const Function& fun, sapply_strings_tag ){
+            std::vector<string_result> results( vec.size() ) ;
+            parallel::transform( vec.begin(), vec.end(), results.begin(), 
+                string_result_wrapper<Function, eT>(fun) 
+            ) ;
+            intern_strings( target, results ) ;
+        }
+        
+        template <typename eT, typename Target, typename Expr, typename Function>
+        inline void sapply_apply_parallel( Target& target, const Expr& vec, const Function& fun, sapply_utf8_strings_tag ){
+            std::vector<const char*> inputs = utf8_inputs(vec) ;
+            std::vector<string_result> results( inputs.size() ) ;
+            parallel::transform( inputs.begin(), inputs.end(), results.begin(), 
+                string_result_wrapper<decltype(fun.fun), const char*>(fun.fun) 
+            ) ;
+            intern_strings( target, results ) ;
+        }
+        
         template <typename eT, typename Expr, typename Function>
         class Sapply : 
             public SugarVectorExpression<
@@ -80,10 +308,8 @@ namespace Rcpp{
             
             template <typename Target>
             inline void apply_parallel( Target& target ) const {
-                parallel::transform( vec.begin(), vec.end(), 
-                    target.begin(), 
-                    typename function_wrapper_type<function_type, Target, eT>::type(fun)
-                ) ;
+                typedef typename sapply_strategy<eT, function_type, value_type, Target::r_type::value>::type strategy ;
+                sapply_apply_parallel<eT>( target, vec, fun, strategy() ) ;
             }
             
             inline const_iterator begin() const { return const_iterator( fun, vec.begin() ) ; }
@@ -130,9 +356,8 @@ namespace Rcpp{
             
             template <typename Target>
             inline void apply_parallel( Target& target ) const {
-                parallel::transform( vec.begin(), vec.end(), target.begin(), 
-                    typename function_wrapper_type<function_type, Target, elem_type>::type(fun)
-                ) ;
+                typedef typename sapply_strategy<elem_type, function_type, value_type, Target::r_type::value>::type strategy ;
+                sapply_apply_parallel<elem_type>( target, vec, fun, strategy() ) ;
             }
             
             
@@ -179,6 +404,15 @@ namespace Rcpp{
             typedef Function type ;
         } ;
         
+        template <typename Function>
+        struct sugar_dispatch_function_type<Function,String> {
+            typedef typename std::conditional< 
+                is_utf8_compatible<Function>::value, 
+                utf8_function<Function>, 
+                Function
+            >::type type ;
+        } ;
+        
     } // sugar
     
     template <typename eT, typename Expr, typename Function, typename... Args >
@@ -0,0 +1,121 @@
+#ifndef Rcpp__sugar__sapply_chunked_h
+#define Rcpp__sugar__sapply_chunked_h
+
+namespace Rcpp{
+    namespace sugar{
+
+        // calls a vectorised R function on consecutive slices of the input
+        // and splices the results, coerced to RTYPE. The function must return
+        // as many values as it gets. One call is allocated and rebound for
+        // all the slices.
+        //
+        // Applied to a target, the slices are written straight into it.
+        // Accessing the elements (operator[], begin, sugar functions that
+        // read the expression) evaluates all the slices once and keeps the
+        // results, so that it is still one call per slice
+        template <int RTYPE, typename eT, typename Expr>
+        class SapplyChunked :
+            public SugarVectorExpression< typename traits::storage_type<RTYPE>::type, SapplyChunked<RTYPE,eT,Expr> >,
+            public custom_sugar_vector_expression
+        {
+        public:
+            typedef typename traits::storage_type<RTYPE>::type value_type ;
+            typedef Vector<RTYPE> Result ;
+            typedef typename Result::const_iterator const_iterator ;
+            const static int INPUT_RTYPE = traits::r_sexptype_traits<eT>::rtype ;
+
+            SapplyChunked( const SugarVectorExpression<eT,Expr>& vec_, const Function& fun_, R_xlen_t chunk_size_ ) :
+                vec(vec_.get_ref()), fun(fun_), chunk_size(chunk_size_), values(), evaluated(false)
+            {
+                if( chunk_size < 1 ) stop( "chunk size must be positive" ) ;
+            }
+
+            inline R_xlen_t size() const { return vec.size() ; }
+
+            inline value_type operator[]( R_xlen_t i ) const {
+                return results()[i] ;
+            }
+
+            inline const_iterator begin() const { return results().begin() ; }
+            inline const_iterator end() const { return results().end() ; }
+
+            // a target of another type gets the results coerced to its type
+            template <typename Target>
+            inline void apply( Target& target ) const {
+                const int TARGET_RTYPE = Target::r_type::value ;
+                if( evaluated ){
+                    Vector<TARGET_RTYPE> res( r_cast<TARGET_RTYPE>(values) ) ;
+                    std::copy( res.begin(), res.end(), target.begin() ) ;
+                } else {
+                    call_slices<TARGET_RTYPE>( target.begin() ) ;
+                }
+            }
+
+            template <typename Target>
+            inline void apply_serial( Target& target ) const {
+                apply( target ) ;
+            }
+
+            template <typename Target>
+            inline void apply_parallel( Target& target ) const {
+                apply( target ) ;
+            }
+
+        private:
+
+            inline const Result& results() const {
+                if( !evaluated ){
+                    Result res( size() ) ;
+                    call_slices<RTYPE>( res.begin() ) ;
+                    values = res ;
+                    evaluated = true ;
+                }
+                return values ;
+            }
+
+            template <int OUTPUT_RTYPE, typename OutputIterator>
+            void call_slices( OutputIterator out ) const {
+                R_xlen_t n = size() ;
+                PreparedCall call( fun, 1 ) ;
+                auto input = sugar_begin( vec ) ;
+                for( R_xlen_t start=0; start<n; start += chunk_size ){
+                    R_xlen_t m = std::min( chunk_size, n - start ) ;
+                    // a fresh slice each time, the function may keep it
+                    Vector<INPUT_RTYPE> slice( m ) ;
+                    std::copy( input + start, input + start + m, slice.begin() ) ;
+                    Shield<SEXP> res = call( slice ) ;
+                    check_length( res, m ) ;
+                    Vector<OUTPUT_RTYPE> chunk( r_cast<OUTPUT_RTYPE>(res) ) ;
+                    std::copy( chunk.begin(), chunk.end(), out + start ) ;
+                }
+            }
+
+            inline void check_length( SEXP res, R_xlen_t m ) const {
+                if( Rf_xlength(res) != m )
+                    stop( "the function returned %d values for a chunk of %d", Rf_xlength(res), m ) ;
+            }
+
+            const Expr& vec ;
+            Function fun ;
+            R_xlen_t chunk_size ;
+            mutable Result values ;
+            mutable bool evaluated ;
+        } ;
+
+    } // sugar
+
+    // sapply_chunked<RTYPE>(x, f, chunk_size): same as sapply(x, f) for a
+    // vectorised R function f, but f is called once per slice of chunk_size
+    // elements instead of once per element. The results of f are coerced
+    // to RTYPE, e.g.
+    //
+    //     NumericVector y = sapply_chunked<REALSXP>( x, Function("pnorm"), 10000 ) ;
+    //     double total = sum( sapply_chunked<REALSXP>( iv, Function("sqrt") ) ) ;
+    template <int RTYPE, typename eT, typename Expr>
+    inline sugar::SapplyChunked<RTYPE,eT,Expr> sapply_chunked( const SugarVectorExpression<eT,Expr>& x, const Function& fun, R_xlen_t chunk_size = 4096 ){
+        return sugar::SapplyChunked<RTYPE,eT,Expr>( x, fun, chunk_size ) ;
+    }
+
+} // Rcpp
+
+#endif
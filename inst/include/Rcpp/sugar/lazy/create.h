@@ -34,7 +34,7 @@ namespace Rcpp{
             }
             
             template <int INDEX, typename Iterator, typename Target>
-            inline void set_value( Iterator& it, std::false_type ) const {}
+            inline void set_value( Iterator&, std::false_type ) const {}
             
     } ;  
     
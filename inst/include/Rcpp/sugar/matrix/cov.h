@@ -0,0 +1,92 @@
+#ifndef Rcpp__sugar__cov_h
+#define Rcpp__sugar__cov_h
+
+namespace Rcpp{
+    namespace sugar{
+
+        // copy of x with centered columns. As in R, the mean is refined by
+        // a second pass over the column
+        template <typename eT, typename Expr>
+        NumericMatrix centered_columns( const SugarMatrixExpression<eT,Expr>& x ){
+            static_assert( is_summable<eT>::value, "only numeric, integer and logical matrices" ) ;
+            int n = x.nrow(), p = x.ncol() ;
+            NumericMatrix res( n, p ) ;
+            double* out = res.begin() ;
+            double_matrix_reader<eT,Expr> get( x.get_ref(), NA_REAL ) ;
+
+            R_xlen_t grain = std::max<R_xlen_t>( 1, RCPP11_PARALLEL_MINIMUM_SIZE / std::max(n,1) ) ;
+            parallel_for( 0, p, grain, [=]( R_xlen_t begin, R_xlen_t end ){
+                for( R_xlen_t j=begin; j<end; j++){
+                    double* col = out + j * n ;
+                    double sum = 0.0 ;
+                    for( int i=0; i<n; i++){
+                        col[i] = get(i, j) ;
+                        sum += col[i] ;
+                    }
+                    double mean = sum / n ;
+                    double correction = 0.0 ;
+                    for( int i=0; i<n; i++) correction += col[i] - mean ;
+                    mean += correction / n ;
+                    for( int i=0; i<n; i++) col[i] -= mean ;
+                }
+            }) ;
+            return res ;
+        }
+
+        // covariance from the cross product of the centered columns, the
+        // symmetric product only computes one triangle
+        template <typename eT, typename Expr>
+        NumericMatrix covariance( const SugarMatrixExpression<eT,Expr>& x ){
+            int n = x.nrow() ;
+            NumericMatrix res = crossprod( centered_columns(x) ) ;
+            double* c = res.begin() ;
+            double scale = n > 1 ? 1.0 / ( n - 1 ) : NA_REAL ;
+            std::transform( c, c + res.size(), c, [scale]( double v ){ return v * scale ; } ) ;
+
+            SEXP dimnames = get_dimnames( x.get_ref() ) ;
+            if( !Rf_isNull(dimnames) && !Rf_isNull(VECTOR_ELT(dimnames, 1)) ){
+                Shield<SEXP> names = Rf_allocVector( VECSXP, 2 ) ;
+                SET_VECTOR_ELT( names, 0, VECTOR_ELT(dimnames, 1) ) ;
+                SET_VECTOR_ELT( names, 1, VECTOR_ELT(dimnames, 1) ) ;
+                Rf_setAttrib( res, R_DimNamesSymbol, names ) ;
+            }
+            return res ;
+        }
+
+    } // sugar
+
+    // covariance matrix of the columns of x
+    template <typename eT, typename Expr>
+    inline NumericMatrix cov( const SugarMatrixExpression<eT,Expr>& x ){
+        return sugar::covariance( x ) ;
+    }
+
+    // correlation matrix of the columns of x
+    template <typename eT, typename Expr>
+    NumericMatrix cor( const SugarMatrixExpression<eT,Expr>& x ){
+        NumericMatrix res = sugar::covariance( x ) ;
+        int p = res.nrow() ;
+        double* c = res.begin() ;
+
+        std::vector<double> sd(p) ;
+        for( int j=0; j<p; j++) sd[j] = std::sqrt( c[ j + static_cast<R_xlen_t>(p) * j ] ) ;
+
+        const double* psd = sd.data() ;
+        R_xlen_t grain = std::max<R_xlen_t>( 1, RCPP11_PARALLEL_MINIMUM_SIZE / std::max(p,1) ) ;
+        parallel_for( 0, p, grain, [=]( R_xlen_t begin, R_xlen_t end ){
+            for( R_xlen_t j=begin; j<end; j++){
+                double* col = c + j * p ;
+                for( int i=0; i<p; i++){
+                    double r = col[i] / ( psd[i] * psd[j] ) ;
+                    // rounding may take r slightly out of [-1,1]
+                    col[i] = r > 1.0 ? 1.0 : ( r < -1.0 ? -1.0 : r ) ;
+                }
+                if( !std::isnan(col[j]) ) col[j] = 1.0 ;
+            }
+        }) ;
+        return res ;
+    }
+
+} // Rcpp
+
+#endif
@@ -0,0 +1,149 @@
+#ifndef Rcpp__sugar__dist_h
+#define Rcpp__sugar__dist_h
+
+namespace Rcpp{
+    namespace sugar{
+
+        // dimnames of a matrix, R_NilValue for other matrix expressions
+        template <typename Expr>
+        inline SEXP get_dimnames( const Expr& x, std::true_type ){
+            return Rf_getAttrib( x, R_DimNamesSymbol ) ;
+        }
+        
+        template <typename Expr>
+        inline SEXP get_dimnames( const Expr&, std::false_type ){
+            return R_NilValue ;
+        }
+        
+        template <typename Expr>
+        inline SEXP get_dimnames( const Expr& x ){
+            return get_dimnames( x, typename std::is_convertible<Expr,SEXP>::type() ) ;
+        }
+        
+        struct euclidean_distance {
+            inline double update( double acc, double d ) const { return acc + d * d ; }
+            inline double finish( double acc, int count, int p ) const {
+                return std::sqrt( count == p ? acc : acc * p / count ) ;
+            }
+        } ;
+
+        struct manhattan_distance {
+            inline double update( double acc, double d ) const { return acc + std::fabs(d) ; }
+            inline double finish( double acc, int count, int p ) const {
+                return count == p ? acc : acc * p / count ;
+            }
+        } ;
+
+        struct maximum_distance {
+            inline double update( double acc, double d ) const { return std::max( acc, std::fabs(d) ) ; }
+            inline double finish( double acc, int, int ) const { return acc ; }
+        } ;
+
+        // distance between two observations stored contiguously. Without
+        // missing values the loop has no branch and can be vectorized by
+        // the compiler. Otherwise, as in R, coordinates where either is missing
+        // are dropped and the sum is scaled up accordingly
+        template <typename Distance>
+        inline double distance( const Distance& dist, const double* x, const double* y, int p, bool has_na, double na ){
+            double acc = 0.0 ;
+            if( !has_na ){
+                for( int k=0; k<p; k++) acc = dist.update( acc, x[k] - y[k] ) ;
+                return dist.finish( acc, p, p ) ;
+            }
+            int count = 0 ;
+            for( int k=0; k<p; k++){
+                if( std::isnan(x[k]) || std::isnan(y[k]) ) continue ;
+                acc = dist.update( acc, x[k] - y[k] ) ;
+                count++ ;
+            }
+            return count == 0 ? na : dist.finish( acc, count, p ) ;
+        }
+
+        // distances between the rows of the n x p matrix, in the packed lower
+        // triangle used by R's dist objects. Observations are first copied
+        // so that each one is contiguous. The pairs are then processed by
+        // tiles of 64x64 observations on or below the diagonal, each tile
+        // only touches 2 blocks of observations that stay in cache
+        template <typename Distance>
+        void compute_dist( const Distance& dist, const std::vector<double>& rows, int n, int p, bool has_na, double* out ){
+            const R_xlen_t tile = 64 ;
+            R_xlen_t nb = ( n + tile - 1 ) / tile ;
+            R_xlen_t ntiles = nb * ( nb + 1 ) / 2 ;
+            const double* data = rows.data() ;
+            double na = NA_REAL ;
+            R_xlen_t nn = n ;
+
+            R_xlen_t grain = std::max<R_xlen_t>( 1, RCPP11_PARALLEL_MINIMUM_SIZE / ( tile * tile * std::max(p,1) ) ) ;
+            parallel_for( 0, ntiles, grain, [=]( R_xlen_t begin, R_xlen_t end ){
+                // tile t is (bi, bj), with bj <= bi and t = bi*(bi+1)/2 + bj
+                R_xlen_t bi = static_cast<R_xlen_t>( ( std::sqrt( 8.0 * begin + 1.0 ) - 1.0 ) / 2.0 ) ;
+                while( bi * (bi + 1) / 2 > begin ) bi-- ;
+                while( (bi + 1) * (bi + 2) / 2 <= begin ) bi++ ;
+                R_xlen_t bj = begin - bi * (bi + 1) / 2 ;
+
+                for( R_xlen_t t=begin; t<end; t++){
+                    R_xlen_t i_end = std::min( nn, (bi + 1) * tile ) ;
+                    R_xlen_t j_end = std::min( nn, (bj + 1) * tile ) ;
+                    for( R_xlen_t j=bj*tile; j<j_end; j++){
+                        const double* y = data + j * p ;
+                        double* col = out + nn * j - j * (j + 1) / 2 - j - 1 ;
+                        for( R_xlen_t i=std::max(bi*tile, j + 1); i<i_end; i++){
+                            col[i] = distance( dist, data + i * p, y, p, has_na, na ) ;
+                        }
+                    }
+                    if( ++bj > bi ){
+                        bi++ ;
+                        bj = 0 ;
+                    }
+                }
+            }) ;
+        }
+
+    } // sugar
+
+    // dist(x, method) for method "euclidean", "manhattan" or "maximum":
+    // distances between the rows of x, as an object of class "dist"
+    template <typename eT, typename Expr>
+    NumericVector dist( const SugarMatrixExpression<eT,Expr>& x, const std::string& method = "euclidean" ){
+        static_assert( sugar::is_summable<eT>::value, "only numeric, integer and logical matrices" ) ;
+        int n = x.nrow(), p = x.ncol() ;
+
+        // observations as contiguous rows, copied by blocks of 32 rows
+        std::vector<double> rows( static_cast<size_t>(n) * p ) ;
+        double* prows = rows.data() ;
+        sugar::double_matrix_reader<eT,Expr> get( x.get_ref(), NA_REAL ) ;
+        R_xlen_t grain = std::max<R_xlen_t>( 1, RCPP11_PARALLEL_MINIMUM_SIZE / ( 32 * std::max(p,1) ) ) ;
+        parallel_for( 0, ( n + 31 ) / 32, grain, [=]( R_xlen_t begin, R_xlen_t end ){
+            R_xlen_t last = std::min<R_xlen_t>( n, end * 32 ) ;
+            for( int k=0; k<p; k++)
+                for( R_xlen_t i=begin*32; i<last; i++)
+                    prows[i * p + k] = get(i, k) ;
+        }) ;
+        bool has_na = std::any_of( rows.begin(), rows.end(), [](double v){ return std::isnan(v) ; } ) ;
+
+        NumericVector res( static_cast<R_xlen_t>(n) * (n - 1) / 2 ) ;
+        if( method == "euclidean" ){
+            sugar::compute_dist( sugar::euclidean_distance(), rows, n, p, has_na, res.begin() ) ;
+        } else if( method == "manhattan" ){
+            sugar::compute_dist( sugar::manhattan_distance(), rows, n, p, has_na, res.begin() ) ;
+        } else if( method == "maximum" ){
+            sugar::compute_dist( sugar::maximum_distance(), rows, n, p, has_na, res.begin() ) ;
+        } else {
+            stop( "invalid distance method: %s", method ) ;
+        }
+
+        SEXP dimnames = sugar::get_dimnames( x.get_ref() ) ;
+        if( !Rf_isNull(dimnames) && !Rf_isNull(VECTOR_ELT(dimnames, 0)) ){
+            res.attr_sym( RCPP_SYMBOL("Labels") ) = VECTOR_ELT(dimnames, 0) ;
+        }
+        res.attr_sym( RCPP_SYMBOL("Size") ) = n ;
+        res.attr_sym( RCPP_SYMBOL("Diag") ) = false ;
+        res.attr_sym( RCPP_SYMBOL("Upper") ) = false ;
+        res.attr_sym( RCPP_SYMBOL("method") ) = method ;
+        res.attr_sym( R_ClassSymbol ) = "dist" ;
+        return res ;
+    }
+
+} // Rcpp
+
+#endif
@@ -0,0 +1,195 @@
+#ifndef Rcpp__sugar__lstsq_h
+#define Rcpp__sugar__lstsq_h
+
+namespace Rcpp{
+    namespace sugar{
+
+        // columns of the design whose part that is not explained by the
+        // previous columns is below this fraction of their norm are
+        // aliased, their coefficients are NA. Same tolerance as lm.fit,
+        // but see lstsq_qr for which columns are dropped
+        const double lstsq_tolerance = 1e-7 ;
+
+        inline void check_finite( const NumericMatrix& x, const char* what ){
+            const double* start = x.begin() ;
+            if( std::find_if( start, start + x.size(), []( double v ){ return !std::isfinite(v) ; } ) != start + x.size() )
+                stop( "NA/NaN/Inf in '%s'", what ) ;
+        }
+
+        // coefficients from the normal equations t(X) X b = t(X) y. The cross
+        // products are computed in parallel (or by BLAS), then the Cholesky
+        // factor of t(X) X is computed, skipping the aliased columns. Each
+        // column of the right hand side is then solved in parallel. Forming
+        // t(X) X squares the condition number of X, so this is only asked
+        // for explicitly, for well conditioned designs
+        inline void lstsq_normal( const NumericMatrix& X, const NumericMatrix& Y, double* coef ){
+            int p = X.ncol(), q = Y.ncol() ;
+            NumericMatrix L = crossprod( X ) ;
+            NumericMatrix B = crossprod( X, Y ) ;
+            double* l = L.begin() ;
+            const double* b = B.begin() ;
+
+            // lower triangular factor, in place
+            std::vector<char> aliased( p, false ) ;
+            for( int k=0; k<p; k++){
+                double* lk = l + static_cast<R_xlen_t>(p) * k ;
+                double d = lk[k] ;
+                for( int m=0; m<k; m++){
+                    if( !aliased[m] ) d -= l[ k + static_cast<R_xlen_t>(p) * m ] * l[ k + static_cast<R_xlen_t>(p) * m ] ;
+                }
+                if( d <= lstsq_tolerance * lstsq_tolerance * lk[k] || lk[k] == 0.0 ){
+                    aliased[k] = true ;
+                    continue ;
+                }
+                double dk = std::sqrt( d ) ;
+                lk[k] = dk ;
+                for( int i=k+1; i<p; i++){
+                    double s = lk[i] ;
+                    for( int m=0; m<k; m++){
+                        if( !aliased[m] ) s -= l[ i + static_cast<R_xlen_t>(p) * m ] * l[ k + static_cast<R_xlen_t>(p) * m ] ;
+                    }
+                    lk[i] = s / dk ;
+                }
+            }
+
+            const char* is_aliased = aliased.data() ;
+            double na = NA_REAL ;
+            R_xlen_t grain = std::max<R_xlen_t>( 1, RCPP11_PARALLEL_MINIMUM_SIZE / std::max<R_xlen_t>( static_cast<R_xlen_t>(p) * p, 1 ) ) ;
+            parallel_for( 0, q, grain, [=]( R_xlen_t begin, R_xlen_t end ){
+                for( R_xlen_t j=begin; j<end; j++){
+                    double* x = coef + j * p ;
+                    std::copy( b + j * p, b + (j + 1) * p, x ) ;
+                    // L z = b
+                    for( int k=0; k<p; k++){
+                        if( is_aliased[k] ) continue ;
+                        const double* lk = l + static_cast<R_xlen_t>(p) * k ;
+                        x[k] /= lk[k] ;
+                        for( int i=k+1; i<p; i++) x[i] -= lk[i] * x[k] ;
+                    }
+                    // t(L) x = z
+                    for( int k=p-1; k>=0; k--){
+                        if( is_aliased[k] ){
+                            x[k] = na ;
+                            continue ;
+                        }
+                        const double* lk = l + static_cast<R_xlen_t>(p) * k ;
+                        double s = x[k] ;
+                        for( int i=k+1; i<p; i++) if( !is_aliased[i] ) s -= lk[i] * x[i] ;
+                        x[k] = s / lk[k] ;
+                    }
+                }
+            }) ;
+        }
+
+    #if defined(RCPP11_USE_BLAS)
+        // coefficients from the QR decomposition of X with column pivoting
+        // (dgeqp3). The decomposition is computed once for all the columns
+        // of Y. Columns beyond the numerical rank get NA coefficients.
+        //
+        // dgeqp3 moves the column of largest remaining norm first at each
+        // step, and the rank is where |R[k,k]| drops below the tolerance
+        // times |R[1,1]|. lm.fit (dqrdc2) keeps the columns in order and
+        // only moves those that are nearly dependent on the previous ones
+        // to the end. The ranks usually agree, but when columns are nearly
+        // collinear they can disagree on which of them are aliased, and
+        // lm.fit reports the later ones
+        inline void lstsq_qr( const NumericMatrix& X, const NumericMatrix& Y, double* coef ){
+            int n = X.nrow(), p = X.ncol(), q = Y.ncol() ;
+            int k = std::min( n, p ), lda = std::max( n, 1 ), info = 0, query = -1 ;
+            std::vector<double> a( X.begin(), X.end() ), b( Y.begin(), Y.end() ) ;
+            std::vector<int> jpvt( p, 0 ) ;
+            std::vector<double> tau( std::max(k, 1) ) ;
+
+            // workspace queries
+            double size = 0.0 ;
+            F77_CALL(dgeqp3)( &n, &p, a.data(), &lda, jpvt.data(), tau.data(), &size, &query, &info ) ;
+            int lwork = static_cast<int>( size ) ;
+            F77_CALL(dormqr)( "L", "T", &n, &q, &k, a.data(), &lda, tau.data(), b.data(), &lda, &size, &query, &info FCONE FCONE ) ;
+            lwork = std::max( lwork, static_cast<int>( size ) ) ;
+            std::vector<double> work( std::max(lwork, 1) ) ;
+
+            F77_CALL(dgeqp3)( &n, &p, a.data(), &lda, jpvt.data(), tau.data(), work.data(), &lwork, &info ) ;
+            if( info != 0 ) stop( "error code %d from Lapack routine 'dgeqp3'", info ) ;
+
+            int rank = 0 ;
+            double r11 = k > 0 ? std::fabs( a[0] ) : 0.0 ;
+            while( rank < k && std::fabs( a[ rank + static_cast<R_xlen_t>(lda) * rank ] ) > lstsq_tolerance * r11 ) rank++ ;
+
+            F77_CALL(dormqr)( "L", "T", &n, &q, &k, a.data(), &lda, tau.data(), b.data(), &lda, work.data(), &lwork, &info FCONE FCONE ) ;
+            if( info != 0 ) stop( "error code %d from Lapack routine 'dormqr'", info ) ;
+            if( rank > 0 ){
+                F77_CALL(dtrtrs)( "U", "N", "N", &rank, &q, a.data(), &lda, b.data(), &lda, &info FCONE FCONE FCONE ) ;
+                if( info != 0 ) stop( "error code %d from Lapack routine 'dtrtrs'", info ) ;
+            }
+
+            for( int j=0; j<q; j++){
+                double* x = coef + static_cast<R_xlen_t>(p) * j ;
+                const double* bj = b.data() + static_cast<R_xlen_t>(lda) * j ;
+                for( int i=0; i<p; i++) x[ jpvt[i] - 1 ] = i < rank ? bj[i] : NA_REAL ;
+            }
+        }
+    #endif
+
+        inline void lstsq_solve( const NumericMatrix& X, const NumericMatrix& Y, double* coef, const std::string& method ){
+            if( X.nrow() != Y.nrow() ) stop( "incompatible dimensions" ) ;
+            check_finite( X, "x" ) ;
+            check_finite( Y, "y" ) ;
+            if( method == "normal" ){
+                lstsq_normal( X, Y, coef ) ;
+            } else if( method == "qr" ){
+            #if defined(RCPP11_USE_BLAS)
+                lstsq_qr( X, Y, coef ) ;
+            #else
+                stop( "method 'qr' needs Lapack: define RCPP11_USE_BLAS and link with $(LAPACK_LIBS) $(BLAS_LIBS) $(FLIBS), "
+                      "or ask for method 'normal' if the design is well conditioned" ) ;
+            #endif
+            } else {
+                stop( "invalid least squares method: %s", method ) ;
+            }
+        }
+
+        inline SEXP design_colnames( const NumericMatrix& X ){
+            SEXP dimnames = Rf_getAttrib( X, R_DimNamesSymbol ) ;
+            return Rf_isNull(dimnames) ? R_NilValue : VECTOR_ELT( dimnames, 1 ) ;
+        }
+
+    } // sugar
+
+    // lstsq(X, y, method): coefficients of the least squares fit of y on the
+    // columns of X, NA for aliased columns. The method is "qr" (the default,
+    // Lapack, needs RCPP11_USE_BLAS) or "normal" for the normal equations,
+    // which is faster but loses accuracy on ill conditioned designs.
+    // "normal" drops columns in order as lm.fit does, "qr" pivots
+    // on the column norms, so for nearly collinear columns it may report
+    // other columns as aliased than lm.fit. See inst/benchmarks/lstsq.R
+    // for a comparison with lm.fit
+    inline NumericVector lstsq( const NumericMatrix& X, const NumericVector& y, const std::string& method = "qr" ){
+        NumericMatrix Y( y.size(), 1 ) ;
+        std::copy( y.begin(), y.end(), Y.begin() ) ;
+        NumericVector res( X.ncol() ) ;
+        sugar::lstsq_solve( X, Y, res.begin(), method ) ;
+        SEXP names = sugar::design_colnames( X ) ;
+        if( !Rf_isNull(names) ) res.attr_sym( R_NamesSymbol ) = names ;
+        return res ;
+    }
+
+    // batched fit of each column of Y on the same design X, the
+    // decomposition of X is shared. Column j of the result holds the
+    // coefficients for column j of Y
+    inline NumericMatrix lstsq( const NumericMatrix& X, const NumericMatrix& Y, const std::string& method = "qr" ){
+        NumericMatrix res( X.ncol(), Y.ncol() ) ;
+        sugar::lstsq_solve( X, Y, res.begin(), method ) ;
+        SEXP names = sugar::design_colnames( X ) ;
+        SEXP dimnames = Rf_getAttrib( Y, R_DimNamesSymbol ) ;
+        if( !Rf_isNull(names) || !Rf_isNull(dimnames) ){
+            Shield<SEXP> res_dimnames = Rf_allocVector( VECSXP, 2 ) ;
+            SET_VECTOR_ELT( res_dimnames, 0, names ) ;
+            if( !Rf_isNull(dimnames) ) SET_VECTOR_ELT( res_dimnames, 1, VECTOR_ELT(dimnames, 1) ) ;
+            Rf_setAttrib( res, R_DimNamesSymbol, res_dimnames ) ;
+        }
+        return res ;
+    }
+
+} // Rcpp
+
+#endif
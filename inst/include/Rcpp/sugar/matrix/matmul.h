@@ -0,0 +1,189 @@
+#ifndef Rcpp__sugar__matmul_h
+#define Rcpp__sugar__matmul_h
+
+namespace Rcpp{
+    namespace sugar{
+
+        template <typename Expr>
+        struct is_numeric_matrix : std::false_type {} ;
+
+        template <typename Storage>
+        struct is_numeric_matrix< Matrix<REALSXP,Storage> > : std::true_type {} ;
+
+        // products of two numeric matrices go to BLAS when RCPP11_USE_BLAS
+        // is defined
+        template <typename Expr1, typename Expr2>
+        struct use_blas : std::integral_constant<bool,
+        #if defined(RCPP11_USE_BLAS)
+            is_numeric_matrix<Expr1>::value && is_numeric_matrix<Expr2>::value
+        #else
+            false
+        #endif
+        >{} ;
+
+        // reads a matrix expression, or its transpose, as doubles
+        template <typename eT, typename Expr>
+        struct product_operand {
+            product_operand( const Expr& ref, bool transposed_ ) :
+                get(ref, NA_REAL), transposed(transposed_){}
+
+            inline double operator()( int i, int j ) const {
+                return transposed ? get(j,i) : get(i,j) ;
+            }
+
+            double_matrix_reader<eT,Expr> get ;
+            bool transposed ;
+        } ;
+
+        // res = op(x) op(y), with A = op(x) of dimensions (m,k) and
+        // B = op(y) of dimensions (k,n).
+        //
+        // Each thread computes a range of columns of res. Tiles of A and B
+        // are packed into thread local buffers, so that the inner loop
+        // streams through contiguous memory whatever the layout of the
+        // operands, and expressions are only evaluated once per tile. 
+        //
+        // When the result is known to be symmetric, only the tiles on and
+        // above the diagonal are computed, the lower triangle is then copied
+        template <typename eT1, typename Expr1, typename eT2, typename Expr2>
+        void tiled_product( NumericMatrix& res, const Expr1& x, bool tx, const Expr2& y, bool ty, int k, bool symmetric = false ){
+            const int tile_m = 128, tile_n = 64, tile_k = 256 ;
+            int m = res.nrow(), n = res.ncol() ;
+            double* c = res.begin() ;
+            product_operand<eT1,Expr1> A(x, tx) ;
+            product_operand<eT2,Expr2> B(y, ty) ;
+            ScratchBuffer<double> a_buffer( tile_m * tile_k ), b_buffer( tile_k * tile_n ) ;
+
+            R_xlen_t work = std::max<R_xlen_t>( 1, static_cast<R_xlen_t>(m) * k ) ;
+            R_xlen_t grain = std::max<R_xlen_t>( 1, RCPP11_PARALLEL_MINIMUM_SIZE / work ) ;
+            parallel_for( 0, n, grain, [=]( R_xlen_t begin, R_xlen_t end ){
+                double* pa = a_buffer.data() ;
+                double* pb = b_buffer.data() ;
+                for( R_xlen_t j0=begin; j0<end; j0 += tile_n ){
+                    int nj = static_cast<int>( std::min<R_xlen_t>( end - j0, tile_n ) ) ;
+                    std::fill( c + j0 * m, c + (j0 + nj) * m, 0.0 ) ;
+                    int mj = symmetric ? static_cast<int>( std::min<R_xlen_t>( m, j0 + nj ) ) : m ;
+
+                    for( int p0=0; p0<k; p0 += tile_k ){
+                        int np = std::min( k - p0, tile_k ) ;
+                        for( int j=0; j<nj; j++)
+                            for( int p=0; p<np; p++)
+                                pb[p + j*np] = B(p0 + p, j0 + j) ;
+
+                        for( int i0=0; i0<mj; i0 += tile_m ){
+                            int ni = std::min( mj - i0, tile_m ) ;
+                            for( int p=0; p<np; p++)
+                                for( int i=0; i<ni; i++)
+                                    pa[i + p*ni] = A(i0 + i, p0 + p) ;
+
+                            for( int j=0; j<nj; j++){
+                                double* cj = c + (j0 + j) * m + i0 ;
+                                for( int p=0; p<np; p++){
+                                    const double* ap = pa + p*ni ;
+                                    double b = pb[p + j*np] ;
+                                    for( int i=0; i<ni; i++) cj[i] += ap[i] * b ;
+                                }
+                            }
+                        }
+                    }
+                }
+            }) ;
+            
+            if( symmetric ){
+                parallel_for( 0, n, grain, [=]( R_xlen_t begin, R_xlen_t end ){
+                    for( R_xlen_t j=begin; j<end; j++)
+                        for( R_xlen_t i=j+1; i<m; i++) 
+                            c[i + j*m] = c[j + i*m] ;
+                }) ;
+            }
+        }
+
+        template <typename eT1, typename Expr1, typename eT2, typename Expr2>
+        inline void matrix_product( NumericMatrix& res, const SugarMatrixExpression<eT1,Expr1>& x, bool tx, const SugarMatrixExpression<eT2,Expr2>& y, bool ty, int k, std::false_type ){
+            static_assert( is_summable<eT1>::value && is_summable<eT2>::value, "only numeric, integer and logical matrices" ) ;
+            tiled_product<eT1,Expr1,eT2,Expr2>( res, x.get_ref(), tx, y.get_ref(), ty, k ) ;
+        }
+
+        // symmetric products, crossprod(x) and tcrossprod(x)
+        template <typename eT, typename Expr>
+        inline void symmetric_product( NumericMatrix& res, const SugarMatrixExpression<eT,Expr>& x, bool tx, int k, std::false_type ){
+            static_assert( is_summable<eT>::value, "only numeric, integer and logical matrices" ) ;
+            tiled_product<eT,Expr,eT,Expr>( res, x.get_ref(), tx, x.get_ref(), !tx, k, true ) ;
+        }
+
+    #if defined(RCPP11_USE_BLAS)
+        template <typename eT1, typename Expr1, typename eT2, typename Expr2>
+        void matrix_product( NumericMatrix& res, const SugarMatrixExpression<eT1,Expr1>& x, bool tx, const SugarMatrixExpression<eT2,Expr2>& y, bool ty, int k, std::true_type ){
+            int m = res.nrow(), n = res.ncol() ;
+            if( m == 0 || n == 0 ) return ;
+            const double one = 1.0, zero = 0.0 ;
+            int lda = std::max( 1, x.nrow() ), ldb = std::max( 1, y.nrow() ), ldc = m ;
+            F77_CALL(dgemm)( tx ? "T" : "N", ty ? "T" : "N", &m, &n, &k,
+                &one, x.get_ref().begin(), &lda, y.get_ref().begin(), &ldb,
+                &zero, res.begin(), &ldc FCONE FCONE ) ;
+        }
+
+        template <typename eT, typename Expr>
+        void symmetric_product( NumericMatrix& res, const SugarMatrixExpression<eT,Expr>& x, bool tx, int k, std::true_type ){
+            int n = res.nrow() ;
+            if( n == 0 ) return ;
+            const double one = 1.0, zero = 0.0 ;
+            int lda = std::max( 1, x.nrow() ) ;
+            double* c = res.begin() ;
+            F77_CALL(dsyrk)( "U", tx ? "T" : "N", &n, &k, &one, x.get_ref().begin(), &lda, &zero, c, &n FCONE FCONE ) ;
+
+            // dsyrk only computes the upper triangle
+            for( int j=0; j<n; j++)
+                for( int i=j+1; i<n; i++)
+                    c[i + static_cast<R_xlen_t>(n)*j] = c[j + static_cast<R_xlen_t>(n)*i] ;
+        }
+    #endif
+
+    } // sugar
+
+    // x %*% y
+    template <typename eT1, typename Expr1, typename eT2, typename Expr2>
+    NumericMatrix matmul( const SugarMatrixExpression<eT1,Expr1>& x, const SugarMatrixExpression<eT2,Expr2>& y ){
+        if( x.ncol() != y.nrow() ) stop( "non-conformable arguments" ) ;
+        NumericMatrix res( x.nrow(), y.ncol() ) ;
+        sugar::matrix_product( res, x, false, y, false, x.ncol(), typename sugar::use_blas<Expr1,Expr2>::type() ) ;
+        return res ;
+    }
+
+    // t(x) %*% y
+    template <typename eT1, typename Expr1, typename eT2, typename Expr2>
+    NumericMatrix crossprod( const SugarMatrixExpression<eT1,Expr1>& x, const SugarMatrixExpression<eT2,Expr2>& y ){
+        if( x.nrow() != y.nrow() ) stop( "non-conformable arguments" ) ;
+        NumericMatrix res( x.ncol(), y.ncol() ) ;
+        sugar::matrix_product( res, x, true, y, false, x.nrow(), typename sugar::use_blas<Expr1,Expr2>::type() ) ;
+        return res ;
+    }
+
+    // t(x) %*% x
+    template <typename eT, typename Expr>
+    NumericMatrix crossprod( const SugarMatrixExpression<eT,Expr>& x ){
+        NumericMatrix res( x.ncol(), x.ncol() ) ;
+        sugar::symmetric_product( res, x, true, x.nrow(), typename sugar::use_blas<Expr,Expr>::type() ) ;
+        return res ;
+    }
+
+    // x %*% t(y)
+    template <typename eT1, typename Expr1, typename eT2, typename Expr2>
+    NumericMatrix tcrossprod( const SugarMatrixExpression<eT1,Expr1>& x, const SugarMatrixExpression<eT2,Expr2>& y ){
+        if( x.ncol() != y.ncol() ) stop( "non-conformable arguments" ) ;
+        NumericMatrix res( x.nrow(), y.nrow() ) ;
+        sugar::matrix_product( res, x, false, y, true, x.ncol(), typename sugar::use_blas<Expr1,Expr2>::type() ) ;
+        return res ;
+    }
+
+    // x %*% t(x)
+    template <typename eT, typename Expr>
+    NumericMatrix tcrossprod( const SugarMatrixExpression<eT,Expr>& x ){
+        NumericMatrix res( x.nrow(), x.nrow() ) ;
+        sugar::symmetric_product( res, x, false, x.ncol(), typename sugar::use_blas<Expr,Expr>::type() ) ;
+        return res ;
+    }
+
+} // Rcpp
+
+#endif
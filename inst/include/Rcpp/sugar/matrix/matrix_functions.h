@@ -7,5 +7,14 @@
 #include <Rcpp/sugar/matrix/diag.h>
 #include <Rcpp/sugar/matrix/row.h>
 #include <Rcpp/sugar/matrix/col.h>
+#include <Rcpp/sugar/matrix/operators.h>
+#include <Rcpp/sugar/matrix/row_col_sums.h>
+#include <Rcpp/sugar/matrix/matmul.h>
+#include <Rcpp/sugar/matrix/transpose.h>
+#include <Rcpp/sugar/matrix/dist.h>
+#include <Rcpp/sugar/matrix/cov.h>
+#include <Rcpp/sugar/matrix/sweep.h>
+#include <Rcpp/sugar/matrix/sparse.h>
+#include <Rcpp/sugar/matrix/lstsq.h>
 
 #endif
@@ -0,0 +1,228 @@
+#ifndef Rcpp__sugar__matrix_operators_h
+#define Rcpp__sugar__matrix_operators_h
+
+namespace Rcpp{
+    namespace sugar{
+
+        // operands of Matrix_Binary_Op, giving the element (i,j) of a
+        // matrix expression, a scalar or a recycled vector
+        template <typename eT, typename Expr>
+        struct matrix_operand {
+            typedef eT value_type ;
+
+            matrix_operand( const SugarMatrixExpression<eT,Expr>& expr ) : ref(expr.get_ref()){}
+
+            inline eT operator()( int i, int j ) const { return ref(i,j) ; }
+
+            inline int nrow() const { return ref.nrow() ; }
+            inline int ncol() const { return ref.ncol() ; }
+
+            const Expr& ref ;
+        } ;
+
+        template <typename eT>
+        struct scalar_matrix_operand {
+            typedef eT value_type ;
+
+            scalar_matrix_operand( eT value_ ) : value(value_){}
+
+            inline eT operator()( int, int ) const { return value ; }
+
+            eT value ;
+        } ;
+
+        // the vector is recycled along the columns of the matrix, as in R
+        template <typename eT>
+        struct vector_matrix_operand {
+            typedef eT value_type ;
+            typedef typename traits::vector_of<eT>::type Vec ;
+
+            template <typename Expr>
+            vector_matrix_operand( const SugarVectorExpression<eT,Expr>& expr, int nr_, int nc_ ) :
+                data(expr), start(data.begin()), n(data.size()), nr(nr_)
+            {
+                if( n == 0 || n > static_cast<R_xlen_t>(nr_) * nc_ )
+                    stop( "dims [product %d] do not match the length of object [%d]", nr_ * nc_, n ) ;
+            }
+
+            inline eT operator()( int i, int j ) const {
+                R_xlen_t k = i + static_cast<R_xlen_t>(nr) * j ;
+                return start[ k < n ? k : k % n ] ;
+            }
+
+            Vec data ;
+            typename Vec::const_iterator start ;
+            R_xlen_t n ;
+            int nr ;
+        } ;
+
+        // lazy element-wise operation between two operands, evaluated in one
+        // pass into the target matrix. Missing values propagate.
+        template <typename Function, typename Lhs, typename Rhs>
+        class Matrix_Binary_Op : public SugarMatrixExpression<
+            typename std::conditional<
+                std::is_same<bool, typename std::result_of<Function(typename Lhs::value_type, typename Rhs::value_type)>::type>::value,
+                Rboolean,
+                typename std::result_of<Function(typename Lhs::value_type, typename Rhs::value_type)>::type
+            >::type,
+            Matrix_Binary_Op<Function,Lhs,Rhs>
+        > {
+        public:
+            typedef typename std::result_of<Function(typename Lhs::value_type, typename Rhs::value_type)>::type real_value_type ;
+            typedef typename std::conditional< std::is_same<bool,real_value_type>::value, Rboolean, real_value_type>::type value_type ;
+
+            Matrix_Binary_Op( Function fun_, const Lhs& lhs_, const Rhs& rhs_, int nr_, int nc_ ) :
+                fun(fun_), lhs(lhs_), rhs(rhs_), nr(nr_), nc(nc_){}
+
+            inline value_type operator()( int i, int j ) const {
+                typename Lhs::value_type x = lhs(i,j) ;
+                typename Rhs::value_type y = rhs(i,j) ;
+                if( x == NA || y == NA ) return NA ;
+                return internal::caster<real_value_type,value_type>( fun(x, y) ) ;
+            }
+
+            inline R_xlen_t size() const { return static_cast<R_xlen_t>(nr) * nc ; }
+            inline int nrow() const { return nr; }
+            inline int ncol() const { return nc; }
+
+        private:
+            Function fun ;
+            Lhs lhs ;
+            Rhs rhs ;
+            int nr, nc ;
+        } ;
+
+        template <typename Function, typename eT, typename Expr1, typename Expr2>
+        inline Matrix_Binary_Op<Function, matrix_operand<eT,Expr1>, matrix_operand<eT,Expr2> >
+        matrix_binary_op( Function fun, const SugarMatrixExpression<eT,Expr1>& lhs, const SugarMatrixExpression<eT,Expr2>& rhs ){
+            if( lhs.nrow() != rhs.nrow() || lhs.ncol() != rhs.ncol() )
+                stop( "non-conformable arrays: (%d,%d) and (%d,%d)", lhs.nrow(), lhs.ncol(), rhs.nrow(), rhs.ncol() ) ;
+            return Matrix_Binary_Op<Function, matrix_operand<eT,Expr1>, matrix_operand<eT,Expr2> >(
+                fun, lhs, rhs, lhs.nrow(), lhs.ncol()
+            ) ;
+        }
+
+        template <typename Function, typename eT, typename Expr>
+        inline Matrix_Binary_Op<Function, matrix_operand<eT,Expr>, scalar_matrix_operand<eT> >
+        matrix_binary_op( Function fun, const SugarMatrixExpression<eT,Expr>& lhs, eT rhs ){
+            return Matrix_Binary_Op<Function, matrix_operand<eT,Expr>, scalar_matrix_operand<eT> >(
+                fun, lhs, rhs, lhs.nrow(), lhs.ncol()
+            ) ;
+        }
+
+        template <typename Function, typename eT, typename Expr>
+        inline Matrix_Binary_Op<Function, scalar_matrix_operand<eT>, matrix_operand<eT,Expr> >
+        matrix_binary_op( Function fun, eT lhs, const SugarMatrixExpression<eT,Expr>& rhs ){
+            return Matrix_Binary_Op<Function, scalar_matrix_operand<eT>, matrix_operand<eT,Expr> >(
+                fun, lhs, rhs, rhs.nrow(), rhs.ncol()
+            ) ;
+        }
+
+        template <typename Function, typename eT, typename Expr1, typename Expr2>
+        inline Matrix_Binary_Op<Function, matrix_operand<eT,Expr1>, vector_matrix_operand<eT> >
+        matrix_binary_op( Function fun, const SugarMatrixExpression<eT,Expr1>& lhs, const SugarVectorExpression<eT,Expr2>& rhs ){
+            return Matrix_Binary_Op<Function, matrix_operand<eT,Expr1>, vector_matrix_operand<eT> >(
+                fun, lhs, vector_matrix_operand<eT>(rhs, lhs.nrow(), lhs.ncol()), lhs.nrow(), lhs.ncol()
+            ) ;
+        }
+
+        template <typename Function, typename eT, typename Expr1, typename Expr2>
+        inline Matrix_Binary_Op<Function, vector_matrix_operand<eT>, matrix_operand<eT,Expr2> >
+        matrix_binary_op( Function fun, const SugarVectorExpression<eT,Expr1>& lhs, const SugarMatrixExpression<eT,Expr2>& rhs ){
+            return Matrix_Binary_Op<Function, vector_matrix_operand<eT>, matrix_operand<eT,Expr2> >(
+                fun, vector_matrix_operand<eT>(lhs, rhs.nrow(), rhs.ncol()), rhs, rhs.nrow(), rhs.ncol()
+            ) ;
+        }
+
+        // a scalar of another arithmetic type than the elements, e.g.
+        // IntegerMatrix * 2.0 or NumericMatrix * 2. As in R, the operation
+        // is done on doubles when either side is a double
+        template <typename eT, typename T, bool = std::is_arithmetic<eT>::value && std::is_arithmetic<T>::value && !std::is_same<eT,T>::value>
+        struct mixed_scalar {} ;
+
+        template <typename eT, typename T>
+        struct mixed_scalar<eT,T,true> {
+            typedef typename std::conditional<
+                std::is_floating_point<eT>::value || std::is_floating_point<T>::value, double, int
+            >::type type ;
+        } ;
+
+        template <typename Function, typename eT, typename Expr, typename T>
+        inline Matrix_Binary_Op<Function, matrix_operand<eT,Expr>, scalar_matrix_operand<T> >
+        matrix_scalar_op( Function fun, const SugarMatrixExpression<eT,Expr>& lhs, T rhs ){
+            return Matrix_Binary_Op<Function, matrix_operand<eT,Expr>, scalar_matrix_operand<T> >(
+                fun, lhs, rhs, lhs.nrow(), lhs.ncol()
+            ) ;
+        }
+
+        template <typename Function, typename eT, typename Expr, typename T>
+        inline Matrix_Binary_Op<Function, scalar_matrix_operand<T>, matrix_operand<eT,Expr> >
+        matrix_scalar_op( Function fun, T lhs, const SugarMatrixExpression<eT,Expr>& rhs ){
+            return Matrix_Binary_Op<Function, scalar_matrix_operand<T>, matrix_operand<eT,Expr> >(
+                fun, lhs, rhs, rhs.nrow(), rhs.ncol()
+            ) ;
+        }
+
+    } // sugar
+} // Rcpp
+
+// element-wise operators between matrices, and between matrices and
+// scalars (of the same type or of another arithmetic type) or vectors
+#define RCPP11_MATRIX_BINARY_OPERATOR(__OPERATOR__,__FUNCTION__)                                               \
+template <typename eT, typename Expr1, typename Expr2>                                                        \
+inline auto operator __OPERATOR__(                                                                            \
+    const Rcpp::SugarMatrixExpression<eT,Expr1>& lhs, const Rcpp::SugarMatrixExpression<eT,Expr2>& rhs        \
+) -> decltype( Rcpp::sugar::matrix_binary_op( __FUNCTION__<eT>(), lhs, rhs ) ) {                              \
+    return Rcpp::sugar::matrix_binary_op( __FUNCTION__<eT>(), lhs, rhs ) ;                                    \
+}                                                                                                             \
+template <typename eT, typename Expr>                                                                         \
+inline auto operator __OPERATOR__( const Rcpp::SugarMatrixExpression<eT,Expr>& lhs, eT rhs )                  \
+    -> decltype( Rcpp::sugar::matrix_binary_op( __FUNCTION__<eT>(), lhs, rhs ) ) {                            \
+    return Rcpp::sugar::matrix_binary_op( __FUNCTION__<eT>(), lhs, rhs ) ;                                    \
+}                                                                                                             \
+template <typename eT, typename Expr>                                                                         \
+inline auto operator __OPERATOR__( eT lhs, const Rcpp::SugarMatrixExpression<eT,Expr>& rhs )                  \
+    -> decltype( Rcpp::sugar::matrix_binary_op( __FUNCTION__<eT>(), lhs, rhs ) ) {                            \
+    return Rcpp::sugar::matrix_binary_op( __FUNCTION__<eT>(), lhs, rhs ) ;                                    \
+}                                                                                                             \
+template <typename eT, typename Expr, typename T>                                                             \
+inline auto operator __OPERATOR__( const Rcpp::SugarMatrixExpression<eT,Expr>& lhs, T rhs )                   \
+    -> decltype( Rcpp::sugar::matrix_scalar_op(                                                               \
+        __FUNCTION__<typename Rcpp::sugar::mixed_scalar<eT,T>::type>(), lhs, rhs ) ) {                        \
+    return Rcpp::sugar::matrix_scalar_op(                                                                     \
+        __FUNCTION__<typename Rcpp::sugar::mixed_scalar<eT,T>::type>(), lhs, rhs ) ;                          \
+}                                                                                                             \
+template <typename eT, typename Expr, typename T>                                                             \
+inline auto operator __OPERATOR__( T lhs, const Rcpp::SugarMatrixExpression<eT,Expr>& rhs )                   \
+    -> decltype( Rcpp::sugar::matrix_scalar_op(                                                               \
+        __FUNCTION__<typename Rcpp::sugar::mixed_scalar<eT,T>::type>(), lhs, rhs ) ) {                        \
+    return Rcpp::sugar::matrix_scalar_op(                                                                     \
+        __FUNCTION__<typename Rcpp::sugar::mixed_scalar<eT,T>::type>(), lhs, rhs ) ;                          \
+}                                                                                                             \
+template <typename eT, typename Expr1, typename Expr2>                                                        \
+inline auto operator __OPERATOR__(                                                                            \
+    const Rcpp::SugarMatrixExpression<eT,Expr1>& lhs, const Rcpp::SugarVectorExpression<eT,Expr2>& rhs        \
+) -> decltype( Rcpp::sugar::matrix_binary_op( __FUNCTION__<eT>(), lhs, rhs ) ) {                              \
+    return Rcpp::sugar::matrix_binary_op( __FUNCTION__<eT>(), lhs, rhs ) ;                                    \
+}                                                                                                             \
+template <typename eT, typename Expr1, typename Expr2>                                                        \
+inline auto operator __OPERATOR__(                                                                            \
+    const Rcpp::SugarVectorExpression<eT,Expr1>& lhs, const Rcpp::SugarMatrixExpression<eT,Expr2>& rhs        \
+) -> decltype( Rcpp::sugar::matrix_binary_op( __FUNCTION__<eT>(), lhs, rhs ) ) {                              \
+    return Rcpp::sugar::matrix_binary_op( __FUNCTION__<eT>(), lhs, rhs ) ;                                    \
+}
+
+RCPP11_MATRIX_BINARY_OPERATOR(+ , std::plus          )
+RCPP11_MATRIX_BINARY_OPERATOR(- , std::minus         )
+RCPP11_MATRIX_BINARY_OPERATOR(* , std::multiplies    )
+RCPP11_MATRIX_BINARY_OPERATOR(/ , std::divides       )
+RCPP11_MATRIX_BINARY_OPERATOR(< , std::less          )
+RCPP11_MATRIX_BINARY_OPERATOR(> , std::greater       )
+RCPP11_MATRIX_BINARY_OPERATOR(<=, std::less_equal    )
+RCPP11_MATRIX_BINARY_OPERATOR(>=, std::greater_equal )
+RCPP11_MATRIX_BINARY_OPERATOR(==, std::equal_to      )
+RCPP11_MATRIX_BINARY_OPERATOR(!=, std::not_equal_to  )
+
+#undef RCPP11_MATRIX_BINARY_OPERATOR
+
+#endif
@@ -0,0 +1,139 @@
+#ifndef Rcpp__sugar__row_col_sums_h
+#define Rcpp__sugar__row_col_sums_h
+
+namespace Rcpp{
+    namespace sugar{
+
+        // reads the elements of a numeric, integer or logical matrix expression
+        // as double, missing values become NA_REAL. Matrices are read directly
+        // from their column major storage. Used from the worker threads
+        template <typename eT, typename Expr, bool dense = traits::has_iterator<Expr>::value>
+        struct double_matrix_reader {
+            double_matrix_reader( const Expr& ref_, double na_ ) : ref(ref_), na(na_){}
+
+            inline double operator()( int i, int j ) const {
+                return get( ref(i,j) ) ;
+            }
+
+            inline double get( double x ) const { return x ; }
+            inline double get( int x ) const { return x == NA_INTEGER ? na : x ; }
+
+            const Expr& ref ;
+            double na ;
+        } ;
+
+        template <typename eT, typename Expr>
+        struct double_matrix_reader<eT,Expr,true> {
+            double_matrix_reader( const Expr& ref, double na_ ) : start(ref.begin()), nr(ref.nrow()), na(na_){}
+
+            inline double operator()( int i, int j ) const {
+                return get( start[ i + static_cast<R_xlen_t>(nr) * j ] ) ;
+            }
+
+            inline double get( double x ) const { return x ; }
+            inline double get( int x ) const { return x == NA_INTEGER ? na : x ; }
+
+            typename Expr::const_iterator start ;
+            int nr ;
+            double na ;
+        } ;
+
+        template <typename eT>
+        struct is_summable : std::integral_constant<bool,
+            std::is_same<eT,double>::value || std::is_same<eT,int>::value || std::is_same<eT,Rboolean>::value
+        >{} ;
+
+        // each column is reduced by one thread, the columns are contiguous
+        template <typename eT, typename Expr>
+        NumericVector col_reduce( const SugarMatrixExpression<eT,Expr>& x, bool na_rm, bool mean ){
+            static_assert( is_summable<eT>::value, "only numeric, integer and logical matrices" ) ;
+            int nr = x.nrow(), nc = x.ncol() ;
+            NumericVector res(nc) ;
+            double* out = res.begin() ;
+            double_matrix_reader<eT,Expr> get( x.get_ref(), NA_REAL ) ;
+
+            R_xlen_t grain = std::max<R_xlen_t>( 1, RCPP11_PARALLEL_MINIMUM_SIZE / std::max(nr, 1) ) ;
+            parallel_for( 0, nc, grain, [=]( R_xlen_t begin, R_xlen_t end ){
+                for( R_xlen_t j=begin; j<end; j++){
+                    double sum = 0.0 ;
+                    R_xlen_t count = nr ;
+                    if( na_rm ){
+                        for( int i=0; i<nr; i++){
+                            double value = get(i,j) ;
+                            if( std::isnan(value) ) count-- ; else sum += value ;
+                        }
+                    } else {
+                        for( int i=0; i<nr; i++) sum += get(i,j) ;
+                    }
+                    out[j] = mean ? sum / count : sum ;
+                }
+            }) ;
+            return res ;
+        }
+
+        // each thread takes a range of rows and sweeps the columns through
+        // tiles of rows, accumulating in the result, so that the matrix
+        // is read column by column instead of along its rows
+        template <typename eT, typename Expr>
+        NumericVector row_reduce( const SugarMatrixExpression<eT,Expr>& x, bool na_rm, bool mean ){
+            static_assert( is_summable<eT>::value, "only numeric, integer and logical matrices" ) ;
+            const int tile = 1024 ;
+            int nr = x.nrow(), nc = x.ncol() ;
+            NumericVector res(nr) ;
+            double* out = res.begin() ;
+            double_matrix_reader<eT,Expr> get( x.get_ref(), NA_REAL ) ;
+            ScratchBuffer<int> counts( na_rm ? tile : 0 ) ;
+
+            R_xlen_t grain = std::max<R_xlen_t>( 1, RCPP11_PARALLEL_MINIMUM_SIZE / std::max(nc, 1) ) ;
+            parallel_for( 0, nr, grain, [=]( R_xlen_t begin, R_xlen_t end ){
+                int* count = counts.data() ;
+                for( R_xlen_t first=begin; first<end; first += tile){
+                    int last = static_cast<int>( std::min<R_xlen_t>( end, first + tile ) ) ;
+                    double* acc = out + first ;
+                    int n = last - static_cast<int>(first) ;
+                    std::fill( acc, acc + n, 0.0 ) ;
+                    if( na_rm ){
+                        std::fill( count, count + n, nc ) ;
+                        for( int j=0; j<nc; j++){
+                            for( int i=0; i<n; i++){
+                                double value = get(first + i, j) ;
+                                if( std::isnan(value) ) count[i]-- ; else acc[i] += value ;
+                            }
+                        }
+                        if( mean ) for( int i=0; i<n; i++) acc[i] /= count[i] ;
+                    } else {
+                        for( int j=0; j<nc; j++){
+                            for( int i=0; i<n; i++) acc[i] += get(first + i, j) ;
+                        }
+                        if( mean ) for( int i=0; i<n; i++) acc[i] /= nc ;
+                    }
+                }
+            }) ;
+            return res ;
+        }
+
+    } // sugar
+
+    template <typename eT, typename Expr>
+    inline NumericVector rowSums( const SugarMatrixExpression<eT,Expr>& x, bool na_rm = false ){
+        return sugar::row_reduce( x, na_rm, false ) ;
+    }
+
+    template <typename eT, typename Expr>
+    inline NumericVector colSums( const SugarMatrixExpression<eT,Expr>& x, bool na_rm = false ){
+        return sugar::col_reduce( x, na_rm, false ) ;
+    }
+
+    template <typename eT, typename Expr>
+    inline NumericVector rowMeans( const SugarMatrixExpression<eT,Expr>& x, bool na_rm = false ){
+        return sugar::row_reduce( x, na_rm, true ) ;
+    }
+
+    template <typename eT, typename Expr>
+    inline NumericVector colMeans( const SugarMatrixExpression<eT,Expr>& x, bool na_rm = false ){
+        return sugar::col_reduce( x, na_rm, true ) ;
+    }
+
+} // Rcpp
+
+#endif
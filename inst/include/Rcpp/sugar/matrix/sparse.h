@@ -0,0 +1,213 @@
+#ifndef Rcpp__sugar__sparse_h
+#define Rcpp__sugar__sparse_h
+
+namespace Rcpp{
+    namespace sugar{
+
+        inline R_xlen_t sparse_grain( const SparseMatrix& x, R_xlen_t work_per_nonzero ){
+            R_xlen_t per_column = std::max<R_xlen_t>( 1, x.nnz() / std::max(x.ncol(), 1) ) ;
+            return std::max<R_xlen_t>( 1, RCPP11_PARALLEL_MINIMUM_SIZE / ( per_column * work_per_nonzero ) ) ;
+        }
+
+        // column sums only touch the stored values of each column
+        inline NumericVector sparse_col_reduce( const SparseMatrix& x, bool na_rm, bool mean ){
+            int nr = x.nrow(), nc = x.ncol() ;
+            NumericVector res(nc) ;
+            double* out = res.begin() ;
+            const int* pp = x.column_pointers() ;
+            const double* px = x.values() ;
+
+            parallel_for( 0, nc, sparse_grain(x, 1), [=]( R_xlen_t begin, R_xlen_t end ){
+                for( R_xlen_t j=begin; j<end; j++){
+                    double sum = 0.0 ;
+                    int count = nr ;
+                    for( int k=pp[j]; k<pp[j+1]; k++){
+                        if( na_rm && std::isnan(px[k]) ){
+                            count-- ;
+                            continue ;
+                        }
+                        sum += px[k] ;
+                    }
+                    out[j] = mean ? sum / count : sum ;
+                }
+            }) ;
+            return res ;
+        }
+
+        // each thread accumulates the row sums of its columns, then the
+        // partial sums are added. With na_rm, the second half of the
+        // accumulator counts the missing values of each row
+        inline NumericVector sparse_row_reduce( const SparseMatrix& x, bool na_rm, bool mean ){
+            int nr = x.nrow(), nc = x.ncol() ;
+            const int* pi = x.row_indices() ;
+            const int* pp = x.column_pointers() ;
+            const double* px = x.values() ;
+
+            std::vector<double> acc = parallel_reduce( 0, nc, sparse_grain(x, 1),
+                std::vector<double>( na_rm ? 2 * static_cast<size_t>(nr) : nr, 0.0 ),
+                [=]( R_xlen_t begin, R_xlen_t end, std::vector<double> value ){
+                    double* sums = value.data() ;
+                    double* nas = sums + nr ;
+                    for( R_xlen_t j=begin; j<end; j++){
+                        for( int k=pp[j]; k<pp[j+1]; k++){
+                            if( na_rm && std::isnan(px[k]) ){
+                                nas[ pi[k] ]++ ;
+                                continue ;
+                            }
+                            sums[ pi[k] ] += px[k] ;
+                        }
+                    }
+                    return value ;
+                },
+                []( std::vector<double> a, const std::vector<double>& b ){
+                    for( size_t i=0; i<a.size(); i++) a[i] += b[i] ;
+                    return a ;
+                }
+            ) ;
+
+            NumericVector res(nr) ;
+            for( int i=0; i<nr; i++){
+                double count = na_rm ? nc - acc[nr + i] : nc ;
+                res[i] = mean ? acc[i] / count : acc[i] ;
+            }
+            return res ;
+        }
+
+    } // sugar
+
+    inline NumericVector colSums( const SparseMatrix& x, bool na_rm = false ){
+        return sugar::sparse_col_reduce( x, na_rm, false ) ;
+    }
+
+    inline NumericVector colMeans( const SparseMatrix& x, bool na_rm = false ){
+        return sugar::sparse_col_reduce( x, na_rm, true ) ;
+    }
+
+    inline NumericVector rowSums( const SparseMatrix& x, bool na_rm = false ){
+        return sugar::sparse_row_reduce( x, na_rm, false ) ;
+    }
+
+    inline NumericVector rowMeans( const SparseMatrix& x, bool na_rm = false ){
+        return sugar::sparse_row_reduce( x, na_rm, true ) ;
+    }
+
+    // x %*% y with a sparse x: column j of the result combines the columns
+    // of x weighted by column j of y, in parallel over the columns of y
+    template <typename eT, typename Expr>
+    NumericMatrix matmul( const SparseMatrix& x, const SugarMatrixExpression<eT,Expr>& y ){
+        static_assert( sugar::is_summable<eT>::value, "only numeric, integer and logical matrices" ) ;
+        if( x.ncol() != y.nrow() ) stop( "non-conformable arguments" ) ;
+        int m = x.nrow(), k = x.ncol(), n = y.ncol() ;
+        NumericMatrix res( m, n ) ;
+        double* c = res.begin() ;
+        const int* pi = x.row_indices() ;
+        const int* pp = x.column_pointers() ;
+        const double* px = x.values() ;
+        sugar::double_matrix_reader<eT,Expr> get( y.get_ref(), NA_REAL ) ;
+
+        R_xlen_t grain = std::max<R_xlen_t>( 1, RCPP11_PARALLEL_MINIMUM_SIZE / std::max<R_xlen_t>( 1, x.nnz() ) ) ;
+        parallel_for( 0, n, grain, [=]( R_xlen_t begin, R_xlen_t end ){
+            for( R_xlen_t j=begin; j<end; j++){
+                double* cj = c + j * m ;
+                for( int p=0; p<k; p++){
+                    double b = get(p, j) ;
+                    for( int q=pp[p]; q<pp[p+1]; q++) cj[ pi[q] ] += px[q] * b ;
+                }
+            }
+        }) ;
+        return res ;
+    }
+
+    // x %*% y with a sparse y: column j of the result combines the columns
+    // of x at the rows stored in column j of y
+    template <typename eT, typename Expr>
+    NumericMatrix matmul( const SugarMatrixExpression<eT,Expr>& x, const SparseMatrix& y ){
+        static_assert( sugar::is_summable<eT>::value, "only numeric, integer and logical matrices" ) ;
+        if( x.ncol() != y.nrow() ) stop( "non-conformable arguments" ) ;
+        int m = x.nrow(), n = y.ncol() ;
+        NumericMatrix res( m, n ) ;
+        double* c = res.begin() ;
+        const int* pi = y.row_indices() ;
+        const int* pp = y.column_pointers() ;
+        const double* px = y.values() ;
+        sugar::double_matrix_reader<eT,Expr> get( x.get_ref(), NA_REAL ) ;
+
+        parallel_for( 0, n, sugar::sparse_grain(y, m), [=]( R_xlen_t begin, R_xlen_t end ){
+            for( R_xlen_t j=begin; j<end; j++){
+                double* cj = c + j * m ;
+                for( int q=pp[j]; q<pp[j+1]; q++){
+                    int p = pi[q] ;
+                    double b = px[q] ;
+                    for( int i=0; i<m; i++) cj[i] += get(i, p) * b ;
+                }
+            }
+        }) ;
+        return res ;
+    }
+
+    // t(x) %*% y with a sparse x: dot products of the sparse columns of x
+    // with the columns of y
+    template <typename eT, typename Expr>
+    NumericMatrix crossprod( const SparseMatrix& x, const SugarMatrixExpression<eT,Expr>& y ){
+        static_assert( sugar::is_summable<eT>::value, "only numeric, integer and logical matrices" ) ;
+        if( x.nrow() != y.nrow() ) stop( "non-conformable arguments" ) ;
+        int m = x.ncol(), n = y.ncol() ;
+        NumericMatrix res( m, n ) ;
+        double* c = res.begin() ;
+        const int* pi = x.row_indices() ;
+        const int* pp = x.column_pointers() ;
+        const double* px = x.values() ;
+        sugar::double_matrix_reader<eT,Expr> get( y.get_ref(), NA_REAL ) ;
+
+        R_xlen_t grain = std::max<R_xlen_t>( 1, RCPP11_PARALLEL_MINIMUM_SIZE / std::max<R_xlen_t>( 1, x.nnz() ) ) ;
+        parallel_for( 0, n, grain, [=]( R_xlen_t begin, R_xlen_t end ){
+            for( R_xlen_t j=begin; j<end; j++){
+                double* cj = c + j * m ;
+                for( int p=0; p<m; p++){
+                    double sum = 0.0 ;
+                    for( int q=pp[p]; q<pp[p+1]; q++) sum += px[q] * get( pi[q], j ) ;
+                    cj[p] = sum ;
+                }
+            }
+        }) ;
+        return res ;
+    }
+
+    // t(x) %*% y with a sparse y
+    template <typename eT, typename Expr>
+    NumericMatrix crossprod( const SugarMatrixExpression<eT,Expr>& x, const SparseMatrix& y ){
+        static_assert( sugar::is_summable<eT>::value, "only numeric, integer and logical matrices" ) ;
+        if( x.nrow() != y.nrow() ) stop( "non-conformable arguments" ) ;
+        int m = x.ncol(), n = y.ncol() ;
+        NumericMatrix res( m, n ) ;
+        double* c = res.begin() ;
+        const int* pi = y.row_indices() ;
+        const int* pp = y.column_pointers() ;
+        const double* px = y.values() ;
+        sugar::double_matrix_reader<eT,Expr> get( x.get_ref(), NA_REAL ) ;
+
+        parallel_for( 0, n, sugar::sparse_grain(y, m), [=]( R_xlen_t begin, R_xlen_t end ){
+            for( R_xlen_t j=begin; j<end; j++){
+                double* cj = c + j * m ;
+                for( int p=0; p<m; p++){
+                    double sum = 0.0 ;
+                    for( int q=pp[j]; q<pp[j+1]; q++) sum += get( pi[q], p ) * px[q] ;
+                    cj[p] = sum ;
+                }
+            }
+        }) ;
+        return res ;
+    }
+
+    // products of two sparse matrices use a dense copy of y
+    inline NumericMatrix matmul( const SparseMatrix& x, const SparseMatrix& y ){
+        return matmul( x, NumericMatrix(y) ) ;
+    }
+
+    inline NumericMatrix crossprod( const SparseMatrix& x, const SparseMatrix& y ){
+        return crossprod( x, NumericMatrix(y) ) ;
+    }
+
+} // Rcpp
+
+#endif
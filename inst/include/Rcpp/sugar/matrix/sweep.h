@@ -0,0 +1,176 @@
+#ifndef Rcpp__sugar__sweep_h
+#define Rcpp__sugar__sweep_h
+
+namespace Rcpp{
+    namespace sugar{
+
+        // operand of Matrix_Binary_Op broadcasting a vector of statistics
+        // along the rows (margin 1) or the columns (margin 2) of a matrix
+        template <typename eT>
+        struct margin_matrix_operand {
+            typedef eT value_type ;
+            typedef typename traits::vector_of<eT>::type Vec ;
+
+            template <typename Expr>
+            margin_matrix_operand( const SugarVectorExpression<eT,Expr>& expr, int margin_, int nr, int nc ) :
+                data(expr), start(data.begin()), by_row(margin_ == 1)
+            {
+                if( margin_ != 1 && margin_ != 2 ) stop( "margin must be 1 or 2" ) ;
+                R_xlen_t n = by_row ? nr : nc ;
+                if( data.size() != n )
+                    stop( "length of the statistics [%d] does not match the extent of the margin [%d]", data.size(), n ) ;
+            }
+
+            inline eT operator()( int i, int j ) const {
+                return start[ by_row ? i : j ] ;
+            }
+
+            Vec data ;
+            typename Vec::const_iterator start ;
+            bool by_row ;
+        } ;
+
+        // how columns are centered or scaled: not at all, by a statistic
+        // computed from the column, or by given values
+        struct column_transform {
+            column_transform( bool compute_ ) : compute(compute_), values(nullptr){}
+            column_transform( const double* values_ ) : compute(false), values(values_){}
+
+            inline bool active() const { return compute || values ; }
+
+            bool compute ;
+            const double* values ;
+        } ;
+
+        // fused scale: each column is read once into out, then its
+        // statistics are computed and the transform applied while the
+        // column is still in cache. Missing values are ignored by the
+        // statistics, as in R. out may be the storage of the matrix read by get
+        template <typename Reader>
+        void scale_columns( const Reader& get, double* out, int n, int p, column_transform center, column_transform scale, double* centers, double* scales ){
+            R_xlen_t grain = std::max<R_xlen_t>( 1, RCPP11_PARALLEL_MINIMUM_SIZE / std::max(n,1) ) ;
+            parallel_for( 0, p, grain, [=]( R_xlen_t begin, R_xlen_t end ){
+                for( R_xlen_t j=begin; j<end; j++){
+                    double* col = out + j * n ;
+                    for( int i=0; i<n; i++) col[i] = get(i, j) ;
+
+                    if( center.active() ){
+                        double c ;
+                        if( center.compute ){
+                            double sum = 0.0 ;
+                            int count = 0 ;
+                            for( int i=0; i<n; i++){
+                                if( std::isnan(col[i]) ) continue ;
+                                sum += col[i] ;
+                                count++ ;
+                            }
+                            c = sum / count ;
+                            double correction = 0.0 ;
+                            for( int i=0; i<n; i++) if( !std::isnan(col[i]) ) correction += col[i] - c ;
+                            c += correction / count ;
+                        } else {
+                            c = center.values[j] ;
+                        }
+                        for( int i=0; i<n; i++) col[i] -= c ;
+                        centers[j] = c ;
+                    }
+
+                    if( scale.active() ){
+                        double s ;
+                        if( scale.compute ){
+                            // standard deviation, or root mean square without centering
+                            double ss = 0.0 ;
+                            int count = 0 ;
+                            for( int i=0; i<n; i++){
+                                if( std::isnan(col[i]) ) continue ;
+                                ss += col[i] * col[i] ;
+                                count++ ;
+                            }
+                            s = std::sqrt( ss / std::max( 1, count - 1 ) ) ;
+                        } else {
+                            s = scale.values[j] ;
+                        }
+                        for( int i=0; i<n; i++) col[i] /= s ;
+                        scales[j] = s ;
+                    }
+                }
+            }) ;
+        }
+
+        inline void set_scaled_attribute( SEXP res, SEXP symbol, const NumericVector& values, SEXP dimnames ){
+            if( !Rf_isNull(dimnames) && !Rf_isNull(VECTOR_ELT(dimnames, 1)) ){
+                Rf_setAttrib( values, R_NamesSymbol, VECTOR_ELT(dimnames, 1) ) ;
+            }
+            Rf_setAttrib( res, symbol, values ) ;
+        }
+
+        template <typename eT, typename Expr>
+        NumericMatrix scale_matrix( const SugarMatrixExpression<eT,Expr>& x, column_transform center, column_transform scale ){
+            static_assert( is_summable<eT>::value, "only numeric, integer and logical matrices" ) ;
+            int n = x.nrow(), p = x.ncol() ;
+            NumericMatrix res( n, p ) ;
+            NumericVector centers( center.active() ? p : 0 ), scales( scale.active() ? p : 0 ) ;
+            double_matrix_reader<eT,Expr> get( x.get_ref(), NA_REAL ) ;
+            scale_columns( get, res.begin(), n, p, center, scale, centers.begin(), scales.begin() ) ;
+
+            SEXP dimnames = get_dimnames( x.get_ref() ) ;
+            if( !Rf_isNull(dimnames) ) Rf_setAttrib( res, R_DimNamesSymbol, dimnames ) ;
+            if( center.active() ) set_scaled_attribute( res, RCPP_SYMBOL("scaled:center"), centers, dimnames ) ;
+            if( scale.active() ) set_scaled_attribute( res, RCPP_SYMBOL("scaled:scale"), scales, dimnames ) ;
+            return res ;
+        }
+
+    } // sugar
+
+    // sweep(x, margin, stats, fun): fun(x(i,j), stats[i]) for margin 1 or
+    // fun(x(i,j), stats[j]) for margin 2. The result is a lazy matrix
+    // expression, so e.g. `x = sweep(x, 2, m)` works in place
+    template <typename Function, typename eT, typename Expr1, typename Expr2>
+    inline sugar::Matrix_Binary_Op<Function, sugar::matrix_operand<eT,Expr1>, sugar::margin_matrix_operand<eT> >
+    sweep( const SugarMatrixExpression<eT,Expr1>& x, int margin, const SugarVectorExpression<eT,Expr2>& stats, Function fun ){
+        return sugar::Matrix_Binary_Op<Function, sugar::matrix_operand<eT,Expr1>, sugar::margin_matrix_operand<eT> >(
+            fun, x, sugar::margin_matrix_operand<eT>(stats, margin, x.nrow(), x.ncol()), x.nrow(), x.ncol()
+        ) ;
+    }
+
+    template <typename eT, typename Expr1, typename Expr2>
+    inline sugar::Matrix_Binary_Op<std::minus<eT>, sugar::matrix_operand<eT,Expr1>, sugar::margin_matrix_operand<eT> >
+    sweep( const SugarMatrixExpression<eT,Expr1>& x, int margin, const SugarVectorExpression<eT,Expr2>& stats ){
+        return sweep( x, margin, stats, std::minus<eT>() ) ;
+    }
+
+    // scale(x, center, scale): centers and/or scales the columns of x by
+    // their means and standard deviations, with the "scaled:center" and
+    // "scaled:scale" attributes of R's scale
+    template <typename eT, typename Expr>
+    inline NumericMatrix scale( const SugarMatrixExpression<eT,Expr>& x, bool center = true, bool scale = true ){
+        return sugar::scale_matrix( x, sugar::column_transform(center), sugar::column_transform(scale) ) ;
+    }
+
+    // scale by given centers and scales, one per column
+    template <typename eT, typename Expr>
+    NumericMatrix scale( const SugarMatrixExpression<eT,Expr>& x, const NumericVector& center, const NumericVector& scale ){
+        if( center.size() != x.ncol() || scale.size() != x.ncol() )
+            stop( "length of 'center' and 'scale' must equal the number of columns of 'x'" ) ;
+        return sugar::scale_matrix( x, sugar::column_transform(center.begin()), sugar::column_transform(scale.begin()) ) ;
+    }
+
+    // same as scale, modifying x instead of allocating the result. x must
+    // not be shared with other R objects
+    inline NumericMatrix& scale_inplace( NumericMatrix& x, bool center = true, bool scale = true ){
+        if( MAYBE_SHARED(x) ) stop( "cannot scale a shared matrix in place" ) ;
+        int n = x.nrow(), p = x.ncol() ;
+        sugar::column_transform c(center), s(scale) ;
+        NumericVector centers( center ? p : 0 ), scales( scale ? p : 0 ) ;
+        sugar::double_matrix_reader<double,NumericMatrix> get( x, NA_REAL ) ;
+        sugar::scale_columns( get, x.begin(), n, p, c, s, centers.begin(), scales.begin() ) ;
+
+        SEXP dimnames = Rf_getAttrib( x, R_DimNamesSymbol ) ;
+        if( center ) sugar::set_scaled_attribute( x, RCPP_SYMBOL("scaled:center"), centers, dimnames ) ;
+        if( scale ) sugar::set_scaled_attribute( x, RCPP_SYMBOL("scaled:scale"), scales, dimnames ) ;
+        return x ;
+    }
+
+} // Rcpp
+
+#endif
@@ -0,0 +1,195 @@
+#ifndef Rcpp__sugar__transpose_h
+#define Rcpp__sugar__transpose_h
+
+namespace Rcpp{
+    namespace sugar{
+
+        // copies a ni x nj block, where element (i,j) is at offset
+        // i*is_i + j*is_j in the source and i*os_i + j*os_j in the target,
+        // by calling copy(target offset, source offset).
+        //
+        // The larger dimension is split in halves until the block is at most
+        // 32x32, so that both the reads and the writes of a block stay in
+        // cache whatever the cache sizes are
+        template <typename Copy>
+        void copy_strided_block( Copy& copy,
+            R_xlen_t in, R_xlen_t is_i, R_xlen_t is_j,
+            R_xlen_t out, R_xlen_t os_i, R_xlen_t os_j,
+            R_xlen_t ni, R_xlen_t nj
+        ){
+            const R_xlen_t tile = 32 ;
+            while( ni > tile || nj > tile ){
+                if( ni >= nj ){
+                    R_xlen_t half = ni / 2 ;
+                    copy_strided_block( copy, in, is_i, is_j, out, os_i, os_j, half, nj ) ;
+                    in += half * is_i ; out += half * os_i ; ni -= half ;
+                } else {
+                    R_xlen_t half = nj / 2 ;
+                    copy_strided_block( copy, in, is_i, is_j, out, os_i, os_j, ni, half ) ;
+                    in += half * is_j ; out += half * os_j ; nj -= half ;
+                }
+            }
+            for( R_xlen_t j=0; j<nj; j++){
+                for( R_xlen_t i=0; i<ni; i++){
+                    copy( out + i*os_i + j*os_j, in + i*is_i + j*is_j ) ;
+                }
+            }
+        }
+
+        // permutes the dimensions of an array of dimensions dims: dimension
+        // k of the result is dimension perm[k] of the source. Elements are
+        // moved by copy(target offset, source offset).
+        //
+        // The work is split in blocks covering the first dimension of the
+        // result, which is contiguous in the target, and up to 32 indices of
+        // the dimension of the result that is contiguous in the source. The
+        // blocks are processed in parallel when `parallel` is true
+        template <typename Copy>
+        void permute_dimensions( const std::vector<int>& dims, const std::vector<int>& perm, Copy copy, bool parallel ){
+            const R_xlen_t tile = 32 ;
+            int N = dims.size() ;
+
+            std::vector<R_xlen_t> source_strides(N), target_strides(N) ;
+            std::vector<int> target_dims(N) ;
+            R_xlen_t total = 1 ;
+            for( int k=0; k<N; k++){
+                source_strides[k] = total ;
+                total *= dims[k] ;
+            }
+            if( total == 0 ) return ;
+
+            R_xlen_t stride = 1 ;
+            int contiguous = 0 ;
+            for( int k=0; k<N; k++){
+                target_dims[k] = dims[perm[k]] ;
+                target_strides[k] = stride ;
+                stride *= target_dims[k] ;
+                if( perm[k] == 0 ) contiguous = k ;
+            }
+
+            // dimension i: first dimension of the result
+            R_xlen_t ni = target_dims[0], is_i = source_strides[perm[0]] ;
+
+            // dimension j: contiguous in the source, unless it is also i
+            R_xlen_t nj = 1, is_j = 0, os_j = 0 ;
+            if( contiguous != 0 ){
+                nj = target_dims[contiguous] ;
+                is_j = 1 ;
+                os_j = target_strides[contiguous] ;
+            }
+            R_xlen_t stripes = ( nj + tile - 1 ) / tile ;
+
+            std::vector<int> others ;
+            for( int k=1; k<N; k++) if( k != contiguous ) others.push_back(k) ;
+
+            auto process = [=]( R_xlen_t begin, R_xlen_t end ) mutable {
+                for( R_xlen_t unit=begin; unit<end; unit++){
+                    R_xlen_t stripe = unit % stripes, combination = unit / stripes ;
+                    R_xlen_t in = stripe * tile * is_j, out = stripe * tile * os_j ;
+                    for( int k: others ){
+                        R_xlen_t index = combination % target_dims[k] ;
+                        combination /= target_dims[k] ;
+                        in  += index * source_strides[perm[k]] ;
+                        out += index * target_strides[k] ;
+                    }
+                    R_xlen_t width = std::min( tile, nj - stripe * tile ) ;
+                    copy_strided_block( copy, in, is_i, is_j, out, 1, os_j, ni, width ) ;
+                }
+            } ;
+
+            R_xlen_t units = total / ( ni * nj ) * stripes ;
+            if( parallel ){
+                R_xlen_t grain = std::max<R_xlen_t>( 1, RCPP11_PARALLEL_MINIMUM_SIZE / ( ni * tile ) ) ;
+                parallel_for( 0, units, grain, process ) ;
+            } else {
+                process( 0, units ) ;
+            }
+        }
+
+        // dimnames of the result of permute_dimensions
+        inline void permute_dimnames( SEXP x, SEXP res, const std::vector<int>& perm ){
+            SEXP dimnames = Rf_getAttrib( x, R_DimNamesSymbol ) ;
+            if( Rf_isNull(dimnames) ) return ;
+
+            int N = perm.size() ;
+            Shield<SEXP> new_dimnames = Rf_allocVector( VECSXP, N ) ;
+            for( int k=0; k<N; k++){
+                SET_VECTOR_ELT( new_dimnames, k, VECTOR_ELT(dimnames, perm[k]) ) ;
+            }
+            SEXP names = Rf_getAttrib( dimnames, R_NamesSymbol ) ;
+            if( !Rf_isNull(names) ){
+                Shield<SEXP> new_names = Rf_allocVector( STRSXP, N ) ;
+                for( int k=0; k<N; k++){
+                    SET_STRING_ELT( new_names, k, STRING_ELT(names, perm[k]) ) ;
+                }
+                Rf_setAttrib( new_dimnames, R_NamesSymbol, new_names ) ;
+            }
+            Rf_setAttrib( res, R_DimNamesSymbol, new_dimnames ) ;
+        }
+
+        // threads work on the storage directly, vectors of R objects
+        // are permuted on the calling thread through their proxies
+        template <int RTYPE, typename Target, typename Source>
+        inline void permute_data( Target& target, const Source& source, const std::vector<int>& dims, const std::vector<int>& perm, std::true_type ){
+            typedef typename traits::storage_type<RTYPE>::type STORAGE ;
+            STORAGE* out = target.begin() ;
+            const STORAGE* in = source.begin() ;
+            permute_dimensions( dims, perm, [out,in]( R_xlen_t o, R_xlen_t i ){ out[o] = in[i] ; }, true ) ;
+        }
+
+        template <int RTYPE, typename Target, typename Source>
+        inline void permute_data( Target& target, const Source& source, const std::vector<int>& dims, const std::vector<int>& perm, std::false_type ){
+            auto out = target.begin() ;
+            auto in = source.begin() ;
+            permute_dimensions( dims, perm, [&out,&in]( R_xlen_t o, R_xlen_t i ){ *(out + o) = *(in + i) ; }, false ) ;
+        }
+
+    } // sugar
+
+    // t(x)
+    template <int RTYPE, typename Storage>
+    Matrix<RTYPE> transpose( const Matrix<RTYPE,Storage>& x ){
+        std::vector<int> dims{ x.nrow(), x.ncol() }, perm{ 1, 0 } ;
+        Matrix<RTYPE> res( x.ncol(), x.nrow() ) ;
+        sugar::permute_data<RTYPE>( res, x, dims, perm,
+            typename traits::is_primitive< typename traits::storage_type<RTYPE>::type >::type()
+        ) ;
+        sugar::permute_dimnames( x, res, perm ) ;
+        return res ;
+    }
+
+    // aperm(x, perm), but perm is 0-based: dimension k of the result is
+    // dimension perm[k] of x. N is only deduced from x, std::array has a
+    // size_t size so perm could not give it
+    template <int N, int RTYPE, typename Storage>
+    Array<N,RTYPE> aperm( const Array<N,RTYPE,Storage>& x, const typename std::common_type<std::array<int,N>>::type& perm ){
+        std::vector<bool> seen(N, false) ;
+        for( int k=0; k<N; k++){
+            if( perm[k] < 0 || perm[k] >= N || seen[perm[k]] ) stop( "invalid 'perm' argument" ) ;
+            seen[perm[k]] = true ;
+        }
+
+        const std::array<int,N>& dims = x.dims() ;
+        std::array<int,N> new_dims ;
+        for( int k=0; k<N; k++) new_dims[k] = dims[perm[k]] ;
+
+        Array<N,RTYPE> res( new_dims ) ;
+        std::vector<int> dims_( dims.begin(), dims.end() ), perm_( perm.begin(), perm.end() ) ;
+        sugar::permute_data<RTYPE>( res, x, dims_, perm_,
+            typename traits::is_primitive< typename traits::storage_type<RTYPE>::type >::type()
+        ) ;
+        sugar::permute_dimnames( x, res, perm_ ) ;
+        return res ;
+    }
+
+    // reverses the dimensions, as aperm(x) in R
+    template <int N, int RTYPE, typename Storage>
+    inline Array<N,RTYPE> aperm( const Array<N,RTYPE,Storage>& x ){
+        std::array<int,N> perm ;
+        for( int k=0; k<N; k++) perm[k] = N - 1 - k ;
+        return aperm( x, perm ) ;
+    }
+
+} // Rcpp
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef Rcpp__traits__is_callable__h
+#define Rcpp__traits__is_callable__h
+
+namespace Rcpp{
+    namespace traits{
+    
+        template <typename Function, typename... Args>
+        class is_callable_helper {
+            template <typename F>
+            static auto test(int) -> decltype( std::declval<F&>()( std::declval<Args>()... ), std::true_type() ) ;
+            
+            template <typename F>
+            static std::false_type test(...) ;
+            
+        public:
+            typedef decltype( test<Function>(0) ) type ;
+        } ;
+        
+        // can a Function be called with arguments of types Args...
+        template <typename Function, typename... Args>
+        struct is_callable : public is_callable_helper<Function,Args...>::type {} ;
+        
+    }
+}
+
+#endif
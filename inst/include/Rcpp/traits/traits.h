@@ -38,5 +38,6 @@
 #include <Rcpp/traits/is_mapply_compatible.h>
 #include <Rcpp/traits/same_mapply_scalar_type.h>
 #include <Rcpp/traits/vector_of.h>
+#include <Rcpp/traits/is_callable.h>
 
 #endif
@@ -6,20 +6,10 @@ namespace Rcpp{
         
         template <typename OutputIterator, typename Size, typename Generator>
         inline void generate_n( OutputIterator begin, Size n, Generator gen ){ 
-            int nthreads = RCPP11_PARALLEL_NTHREADS ;
-            if( n > RCPP11_PARALLEL_MINIMUM_SIZE ){
-                std::vector<std::thread> workers(nthreads-1) ;
-                Size chunk_size = n / nthreads ;
-                Size pos = 0;
-                for( int i=0; i<nthreads-1; i++, pos += chunk_size){
-                    workers[i] = std::thread( std::generate_n<OutputIterator, R_xlen_t, Generator>, 
-                        begin + pos, chunk_size, gen) ;   
-                }
-                std::generate_n( begin + pos, n-pos, gen ) ;
-                for( int i=0; i<nthreads-1; i++) workers[i].join() ;
-            } else {
-                std::generate_n( begin, n, gen ) ;
-            }
+            // each thread works with its own copy of the generator
+            run( n, [=]( R_xlen_t first, R_xlen_t last ) mutable {
+                std::generate_n( begin + first, last - first, std::ref(gen) ) ;
+            }) ;
         }
         
     }    
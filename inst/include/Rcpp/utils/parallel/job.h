@@ -0,0 +1,228 @@
+#ifndef RCPP11_TOOLS_JOB_PARALLEL_H
+#define RCPP11_TOOLS_JOB_PARALLEL_H
+
+namespace Rcpp{
+    namespace parallel{
+
+        // true in the threads started by a parallel job
+        inline bool& in_worker_thread(){
+            static thread_local bool flag = false ;
+            return flag ;
+        }
+
+        // id of R's main thread, recorded when the library is loaded:
+        // R loads shared libraries from its main thread
+        inline std::thread::id& main_thread_id(){
+            static std::thread::id id ;
+            return id ;
+        }
+
+        namespace {
+            struct MainThreadRecorder {
+                MainThreadRecorder(){
+                    main_thread_id() = std::this_thread::get_id() ;
+                }
+            } ;
+            MainThreadRecorder record_main_thread ;
+        }
+
+        // Parallel algorithms only start threads and check for interrupts
+        // from R's main thread. Called from any other thread, e.g. a worker
+        // or a std::thread started by the user, they run serially and never
+        // call the R API
+        inline bool on_main_thread(){
+            return !in_worker_thread() && std::this_thread::get_id() == main_thread_id() ;
+        }
+
+        // used by the worker threads, which cannot check for interrupts
+        struct NoInterruptCheck {
+            inline void poll(){}
+        } ;
+
+        // Shared state of a parallel job.
+        //
+        // Each thread processes its chunk in blocks of at least `grain` and
+        // at most RCPP11_PARALLEL_BLOCK_SIZE elements and checks between blocks
+        // whether the job has been cancelled. The first exception thrown by any
+        // thread is captured, cancels the job, and is rethrown on the calling
+        // thread once all the workers are joined, so that errors behave as in
+        // serial mode instead of calling std::terminate
+        //
+        // The calling thread also checks for user interrupts between its blocks
+        // and while it waits for the workers, an interrupt cancels the job
+        class Job {
+        public:
+            Job( R_xlen_t grain_ = 1 ) :
+                grain( std::max<R_xlen_t>(1, grain_) ),
+                cancelled(false), error(), error_mutex(), running(0), state_mutex(), finished()
+            {}
+
+            Job( const Job& ) = delete ;
+            Job& operator=( const Job& ) = delete ;
+
+            inline bool is_cancelled() const {
+                return cancelled.load( std::memory_order_relaxed ) ;
+            }
+
+            // only the first exception is kept
+            inline void cancel( std::exception_ptr e ){
+                std::lock_guard<std::mutex> lock(error_mutex) ;
+                if( !error ) error = e ;
+                cancelled.store( true, std::memory_order_relaxed ) ;
+            }
+
+            // calls fun(chunk, begin, end) on blocks covering [begin,end). Blocks
+            // start small and grow up to RCPP11_PARALLEL_BLOCK_SIZE, they shrink
+            // again when one block takes more than a tenth of the interrupt
+            // check interval, so that slow functions are still cancelled promptly
+            template <typename Fun, typename Check>
+            void process( Fun& fun, int chunk, R_xlen_t begin, R_xlen_t end, Check& check ) noexcept {
+                typedef std::chrono::steady_clock clock ;
+                const clock::duration target = std::chrono::milliseconds(RCPP11_INTERRUPT_CHECK_INTERVAL) / 10 ;
+                const R_xlen_t max_block = std::max<R_xlen_t>( grain, RCPP11_PARALLEL_BLOCK_SIZE ) ;
+                R_xlen_t block = std::max<R_xlen_t>( grain, std::min<R_xlen_t>( 64, max_block ) ) ;
+                try {
+                    while( begin < end && !is_cancelled() ){
+                        R_xlen_t next = std::min<R_xlen_t>( end, begin + block ) ;
+                        clock::time_point start = clock::now() ;
+                        fun( chunk, begin, next ) ;
+                        clock::duration elapsed = clock::now() - start ;
+                        if( elapsed > target ){
+                            block = std::max<R_xlen_t>( grain, block / 2 ) ;
+                        } else if( elapsed < target / 2 && block < max_block ){
+                            block = std::min<R_xlen_t>( 2 * block, max_block ) ;
+                        }
+                        begin = next ;
+                        check.poll() ;
+                    }
+                } catch(...){
+                    cancel( std::current_exception() ) ;
+                }
+            }
+
+            inline void worker_started(){
+                std::lock_guard<std::mutex> lock(state_mutex) ;
+                running++ ;
+            }
+
+            inline void worker_finished(){
+                std::lock_guard<std::mutex> lock(state_mutex) ;
+                running-- ;
+                finished.notify_one() ;
+            }
+
+            // waits for all workers to finish, checking for interrupts
+            template <typename Check>
+            void wait( Check& check ) noexcept {
+                std::unique_lock<std::mutex> lock(state_mutex) ;
+                while( running > 0 ){
+                    finished.wait_for( lock, std::chrono::milliseconds(RCPP11_INTERRUPT_CHECK_INTERVAL) ) ;
+                    if( running == 0 || is_cancelled() ) continue ;
+                    lock.unlock() ;
+                    try {
+                        check.poll() ;
+                    } catch(...){
+                        cancel( std::current_exception() ) ;
+                    }
+                    lock.lock() ;
+                }
+            }
+
+            inline void rethrow() const {
+                if( error ) std::rethrow_exception(error) ;
+            }
+
+        private:
+            R_xlen_t grain ;
+
+            std::atomic<bool> cancelled ;
+            std::exception_ptr error ;
+            std::mutex error_mutex ;
+
+            int running ;
+            std::mutex state_mutex ;
+            std::condition_variable finished ;
+        } ;
+
+        // number of threads used to process n elements in chunks of at
+        // least grain elements. Always 1 away from the main thread
+        inline int number_of_threads( R_xlen_t n, R_xlen_t grain ){
+            if( !on_main_thread() ) return 1 ;
+            R_xlen_t nthreads = RCPP11_PARALLEL_NTHREADS ;
+            return static_cast<int>( std::max<R_xlen_t>( 1,
+                std::min<R_xlen_t>( nthreads, n / std::max<R_xlen_t>(1, grain) )
+            ) ) ;
+        }
+
+        // splits [0,n) into nthreads contiguous chunks and calls
+        // fun(chunk, begin, end) on blocks of each chunk. Chunk i is processed
+        // by the i-th thread, the calling thread takes the last chunk. Each
+        // worker gets its own copy of fun, the calling thread uses fun itself
+        template <typename Fun>
+        void run_chunks( R_xlen_t n, int nthreads, R_xlen_t grain, Fun fun ){
+            Job job(grain) ;
+
+            if( !on_main_thread() ){
+                NoInterruptCheck no_check ;
+                job.process( fun, 0, 0, n, no_check ) ;
+                job.rethrow() ;
+                return ;
+            }
+
+            InterruptChecker check_interrupt ;
+            if( nthreads < 2 ){
+                job.process( fun, 0, 0, n, check_interrupt ) ;
+                job.rethrow() ;
+                return ;
+            }
+
+            std::vector<std::thread> workers ;
+            workers.reserve(nthreads-1) ;
+            R_xlen_t chunk_size = n / nthreads ;
+            R_xlen_t start = 0 ;
+            int chunk = 0 ;
+            try {
+                for( ; chunk<nthreads-1; chunk++, start += chunk_size){
+                    job.worker_started() ;
+                    try {
+                        workers.emplace_back( [&job]( Fun f, int i, R_xlen_t begin, R_xlen_t end ){
+                            in_worker_thread() = true ;
+                            NoInterruptCheck no_check ;
+                            job.process( f, i, begin, end, no_check ) ;
+                            job.worker_finished() ;
+                        }, fun, chunk, start, start + chunk_size ) ;
+                    } catch(...){
+                        job.worker_finished() ;
+                        throw ;
+                    }
+                }
+            } catch(...){
+                // could not start a thread, the workers already started
+                // stop at their next block
+                job.cancel( std::current_exception() ) ;
+            }
+            job.process( fun, nthreads-1, start, n, check_interrupt ) ;
+            job.wait( check_interrupt ) ;
+            for( auto& worker: workers ) worker.join() ;
+            job.rethrow() ;
+        }
+
+        // calls fun(begin, end) on contiguous ranges covering [0,n), in
+        // parallel when n is above RCPP11_PARALLEL_MINIMUM_SIZE. Smaller
+        // ranges are a single call, without the bookkeeping of a job
+        template <typename Fun>
+        void run( R_xlen_t n, Fun fun ){
+            if( n <= RCPP11_PARALLEL_MINIMUM_SIZE ){
+                fun( 0, n ) ;
+                return ;
+            }
+            int nthreads = number_of_threads(n, 1) ;
+            run_chunks( n, nthreads, 1, [fun]( int, R_xlen_t begin, R_xlen_t end ) mutable {
+                fun( begin, end ) ;
+            }) ;
+        }
+
+    }
+}
+
+#endif
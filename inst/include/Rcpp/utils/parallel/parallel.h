@@ -1,9 +1,12 @@
 #ifndef RCPP11_TOOLS_PARALLEL_PARALLEL_H
 #define RCPP11_TOOLS_PARALLEL_PARALLEL_H
 
+#include <Rcpp/utils/parallel/job.h>
 #include <Rcpp/utils/parallel/copy.h>
 #include <Rcpp/utils/parallel/transform.h>
 #include <Rcpp/utils/parallel/iota.h>
 #include <Rcpp/utils/parallel/generate_n.h>
+#include <Rcpp/utils/parallel/parallel_for.h>
+#include <Rcpp/utils/parallel/parallel_reduce.h>
       
 #endif                      
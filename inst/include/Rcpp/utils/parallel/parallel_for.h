@@ -0,0 +1,82 @@
+#ifndef RCPP11_TOOLS_PARALLEL_FOR_H
+#define RCPP11_TOOLS_PARALLEL_FOR_H
+
+namespace Rcpp{
+
+    // Calls body(b, e) on contiguous blocks [b,e) covering [begin,end), 
+    // using up to RCPP11_PARALLEL_NTHREADS threads. Blocks have at least 
+    // grain elements (except possibly the last one of each thread), so 
+    // the range is only split when end - begin is at least 2*grain. 
+    //
+    //     NumericVector x(n), y(n) ;
+    //     double* px = x.dataptr() ; double* py = y.dataptr() ;
+    //     parallel_for( 0, n, 1000, [=]( R_xlen_t b, R_xlen_t e ){
+    //         for( R_xlen_t i=b; i<e; i++) py[i] = 2.0 * px[i] ;
+    //     }) ;
+    //
+    // The body runs on worker threads and must not use the R API: no R
+    // allocation, no construction of Rcpp objects, no wrap or as. Work on 
+    // raw pointers obtained on the calling thread instead. Throwing, e.g. 
+    // with stop(), is fine. parallel_for itself only uses the R API from the 
+    // calling thread, to check for user interrupts. 
+    //
+    // Each thread uses its own copy of body, so members of body captured 
+    // by value (e.g. a ScratchBuffer) are thread local. 
+    //
+    // The first exception thrown by body cancels the remaining blocks and 
+    // is rethrown on the calling thread. 
+    template <typename Body>
+    void parallel_for( R_xlen_t begin, R_xlen_t end, R_xlen_t grain, Body body ){
+        R_xlen_t n = end - begin ;
+        if( n <= 0 ) return ;
+        parallel::run_chunks( n, parallel::number_of_threads(n, grain), grain, 
+            [begin,body]( int, R_xlen_t b, R_xlen_t e ) mutable {
+                body( begin + b, begin + e ) ;
+            }
+        ) ;
+    }
+    
+    // Scratch memory for the body of parallel_for or parallel_reduce. 
+    // 
+    // Copies of a ScratchBuffer do not share or copy the memory, each copy 
+    // allocates its own n elements the first time it is used, so capturing 
+    // a buffer by value in the body gives each thread its own buffer, 
+    // reused between the blocks processed by this thread. 
+    //
+    //     ScratchBuffer<double> buffer(nr) ;
+    //     parallel_for( 0, nc, 1, [=]( R_xlen_t b, R_xlen_t e ){
+    //         double* tmp = buffer.data() ;
+    //         ...
+    //     }) ;
+    template <typename T>
+    class ScratchBuffer {
+    public:
+        explicit ScratchBuffer( size_t n_ ) : n(n_), buffer(){}
+        
+        ScratchBuffer( const ScratchBuffer& other ) : n(other.n), buffer(){}
+        
+        ScratchBuffer& operator=( const ScratchBuffer& other ){
+            n = other.n ;
+            buffer.clear() ;
+            return *this ;
+        }
+        
+        // the memory is not part of the logical state of the buffer, so 
+        // a const buffer (captured by a non mutable lambda) gives write access
+        inline T* data() const { 
+            if( buffer.size() != n ) buffer.resize(n) ;
+            return buffer.data() ;
+        }
+        
+        inline T& operator[]( size_t i ) const { return data()[i] ; }
+        
+        inline size_t size() const { return n ; }
+        
+    private:
+        size_t n ;
+        mutable std::vector<T> buffer ;
+    } ;
+    
+}
+
+#endif
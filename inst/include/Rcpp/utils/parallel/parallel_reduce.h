@@ -0,0 +1,66 @@
+#ifndef RCPP11_TOOLS_PARALLEL_REDUCE_H
+#define RCPP11_TOOLS_PARALLEL_REDUCE_H
+
+namespace Rcpp{
+
+    namespace parallel{
+        
+        // one partial result per thread. The wrapper avoids the 
+        // std::vector<bool> specialization, which cannot be written concurrently
+        template <typename T>
+        struct Partial {
+            Partial() : value(){}
+            Partial( const T& value_ ) : value(value_){}
+            Partial( T&& value_ ) : value(std::move(value_)){}
+            T value ;
+        } ;
+        
+    }
+    
+    // Reduces [begin,end) in parallel: 
+    //   - body(b, e, value) processes the block [b,e) and returns value 
+    //     updated with the contribution of the block
+    //   - join(x, y) combines two partial results
+    // 
+    // Each thread starts from its own copy of identity and accumulates its 
+    // contiguous part of the range. Partial results are joined on the calling 
+    // thread in the order of the range, so the result only depends on the 
+    // number of threads, not on their scheduling. 
+    //
+    //     const double* px = x.dataptr() ;
+    //     double total = parallel_reduce( 0, x.size(), 10000, 0.0, 
+    //         [=]( R_xlen_t b, R_xlen_t e, double value ){
+    //             return std::accumulate( px + b, px + e, value ) ;
+    //         }, 
+    //         std::plus<double>() 
+    //     ) ;
+    //
+    // Same rules as parallel_for: the body must not use the R API, each 
+    // thread uses its own copy of body, and exceptions are rethrown on 
+    // the calling thread. 
+    template <typename T, typename Body, typename Join>
+    T parallel_reduce( R_xlen_t begin, R_xlen_t end, R_xlen_t grain, T identity, Body body, Join join ){
+        R_xlen_t n = end - begin ;
+        if( n <= 0 ) return identity ;
+        
+        int nthreads = parallel::number_of_threads(n, grain) ;
+        std::vector< parallel::Partial<T> > partials( nthreads, parallel::Partial<T>(identity) ) ;
+        parallel::Partial<T>* results = partials.data() ;
+        
+        parallel::run_chunks( n, nthreads, grain, 
+            [begin,body,results]( int chunk, R_xlen_t b, R_xlen_t e ) mutable {
+                T& value = results[chunk].value ;
+                value = body( begin + b, begin + e, std::move(value) ) ;
+            }
+        ) ;
+        
+        T res = std::move( partials[0].value ) ;
+        for( int i=1; i<nthreads; i++){
+            res = join( std::move(res), std::move(partials[i].value) ) ;
+        }
+        return res ;
+    }
+    
+}
+
+#endif
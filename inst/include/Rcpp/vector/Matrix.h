@@ -71,11 +71,11 @@ namespace Rcpp{
         }
         inline iterator end(){ return vec.end(); }
                    
-        inline const iterator begin() const {
+        inline const_iterator begin() const {
             RCPP_DEBUG( "Matrix::begin() const = %p", vec.begin() ) ;
             return vec.begin() ; 
         }
-        inline const iterator end() const { return vec.end(); }
+        inline const_iterator end() const { return vec.end(); }
               
         inline Proxy operator[](R_xlen_t i){ return vec[i] ; }
         inline const Proxy operator[](R_xlen_t i) const{ return vec[i] ; }
@@ -90,6 +90,11 @@ namespace Rcpp{
         inline Column column(int i){ return Column(*this, i) ; }
         inline Column operator()(internal::NamedPlaceHolder, int i){ return column(i); }
         
+        // rows [r0,r1) and columns [c0,c1)
+        inline SubMatrix<RTYPE,Matrix> submatrix( int r0, int r1, int c0, int c1 ) const {
+            return SubMatrix<RTYPE,Matrix>( *this, r0, r1, c0, c1 ) ;
+        }
+        
         inline Row row(int i){ return Row(*this, i) ; }
         inline Row operator()(int i, internal::NamedPlaceHolder){ return row(i); }
         
@@ -0,0 +1,119 @@
+#ifndef Rcpp_vector_NameIndex_h
+#define Rcpp_vector_NameIndex_h
+
+namespace Rcpp{
+
+    namespace internal{
+
+        // position of the name in names, -1 if it is not there
+        inline R_xlen_t find_name( SEXP names, const std::string& name ){
+            R_xlen_t n = XLENGTH(names) ;
+            SEXP* data = r_vector_start<STRSXP>(names) ;
+            R_xlen_t index = std::find( data, data+n, Rf_mkChar(name.c_str()) ) - data ;
+            return index == n ? -1 : index ;
+        }
+
+    }
+
+    // hash index of the names of an object: name -> position of the first
+    // element with that name. Built once by the caller and kept for as long
+    // as the lookups, e.g.
+    //
+    //     NameIndex idx(x) ;
+    //     for(...) x[ idx["a"] ] ...
+    //
+    // The index keeps the names vector alive. It is not updated when the
+    // object gets new names, reset(x) rebuilds it
+    class NameIndex {
+    public:
+        NameIndex() : names(R_NilValue), index(){}
+
+        explicit NameIndex( SEXP x ) : names(R_NilValue), index(){
+            reset( x ) ;
+        }
+
+        NameIndex( const NameIndex& ) = delete ;
+        NameIndex& operator=( const NameIndex& ) = delete ;
+
+        ~NameIndex(){
+            Rcpp_ReleaseObject( names ) ;
+        }
+
+        // indexes the names of x
+        void reset( SEXP x ){
+            Shield<SEXP> names_ = RCPP_GET_NAMES(x) ;
+            if( names_ == R_NilValue ) stop( "object has no names" ) ;
+            Rcpp_ReleaseObject( names ) ;
+            names = Rcpp_PreserveObject( names_ ) ;
+            index.clear() ;
+
+            R_xlen_t n = XLENGTH(names) ;
+            index.reserve( n ) ;
+            SEXP* data = internal::r_vector_start<STRSXP>(names) ;
+            for( R_xlen_t i=0; i<n; i++){
+                if( data[i] == NA_STRING ) continue ;
+                // emplace keeps the first position of duplicated names
+                index.emplace( CHAR(data[i]), i ) ;
+            }
+        }
+
+        // true if the index was built from the current names of x
+        inline bool indexes( SEXP x ) const {
+            return names != R_NilValue && RCPP_GET_NAMES(x) == names ;
+        }
+
+        // position of the name, -1 if there is no such name. The names may
+        // have been modified in place, so a hit is checked against them
+        inline R_xlen_t find( const std::string& name ) const {
+            auto it = index.find( name ) ;
+            if( it == index.end() ) return -1 ;
+            if( name == CHAR(STRING_ELT(names, it->second)) ) return it->second ;
+            return internal::find_name( names, name ) ;
+        }
+
+        // position of the name, an error if there is no such name
+        inline R_xlen_t operator[]( const std::string& name ) const {
+            R_xlen_t i = find( name ) ;
+            if( i < 0 ) stop( "no such name '%s'", name ) ;
+            return i ;
+        }
+
+        inline R_xlen_t size() const { return names == R_NilValue ? 0 : XLENGTH(names) ; }
+
+    private:
+        SEXP names ;
+        std::unordered_map<std::string, R_xlen_t> index ;
+    } ;
+
+    namespace internal{
+
+        // positions of the targets in the names of x, written to out.
+        // Returns the position of the first target that is not found, -1
+        // if all are. Several targets among at least
+        // RCPP11_NAME_INDEX_MINIMUM_SIZE names go through an index built
+        // for this call only
+        inline R_xlen_t find_names( SEXP x, SEXP targets, int* out ){
+            R_xlen_t n = XLENGTH(targets) ;
+            SEXP names = RCPP_GET_NAMES(x) ;
+            if( n > 1 && XLENGTH(names) >= RCPP11_NAME_INDEX_MINIMUM_SIZE ){
+                NameIndex index( x ) ;
+                for( R_xlen_t i=0; i<n; i++){
+                    R_xlen_t pos = index.find( CHAR(STRING_ELT(targets, i)) ) ;
+                    if( pos < 0 ) return i ;
+                    out[i] = pos ;
+                }
+            } else {
+                for( R_xlen_t i=0; i<n; i++){
+                    R_xlen_t pos = find_name( names, CHAR(STRING_ELT(targets, i)) ) ;
+                    if( pos < 0 ) return i ;
+                    out[i] = pos ;
+                }
+            }
+            return -1 ;
+        }
+
+    }
+
+}
+
+#endif
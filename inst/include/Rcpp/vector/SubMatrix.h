@@ -0,0 +1,79 @@
+#ifndef Rcpp__vector__SubMatrix_h
+#define Rcpp__vector__SubMatrix_h
+
+namespace Rcpp{
+
+    // view of the rows [r0,r1) and columns [c0,c1) of a matrix. Nothing is
+    // copied until the view is used as a matrix expression. Each column of
+    // the view is a contiguous run of the matrix, and the whole view is a single
+    // run when it spans all the rows
+    template <int RTYPE, typename Mat>
+    class SubMatrix :
+        public SugarMatrixExpression< typename traits::storage_type<RTYPE>::type, SubMatrix<RTYPE,Mat> >,
+        public sugar::custom_sugar_matrix_expression
+    {
+    public:
+        typedef typename traits::storage_type<RTYPE>::type value_type ;
+
+        SubMatrix( const Mat& mat_, int r0_, int r1_, int c0_, int c1_ ) :
+            mat(mat_), r0(r0_), c0(c0_), nr(r1_ - r0_), nc(c1_ - c0_)
+        {
+            if( r0_ < 0 || r1_ < r0_ || r1_ > mat.nrow() || c0_ < 0 || c1_ < c0_ || c1_ > mat.ncol() )
+                stop( "subscript out of bounds" ) ;
+        }
+
+        inline value_type operator()( int i, int j ) const {
+            return mat( r0 + i, c0 + j ) ;
+        }
+
+        inline R_xlen_t size() const { return static_cast<R_xlen_t>(nr) * nc ; }
+        inline int nrow() const { return nr; }
+        inline int ncol() const { return nc; }
+
+        template <typename Target>
+        inline void apply( Target& target ) const {
+            apply_impl( target, typename traits::is_primitive<value_type>::type() ) ;
+        }
+
+    private:
+
+        inline R_xlen_t column_start( int j ) const {
+            return r0 + static_cast<R_xlen_t>( mat.nrow() ) * ( c0 + j ) ;
+        }
+
+        template <typename Target>
+        void apply_impl( Target& target, std::true_type ) const {
+            auto out = target.begin() ;
+            auto in = mat.begin() ;
+            if( nr == mat.nrow() ){
+                parallel::copy( in + column_start(0), in + column_start(nc), out ) ;
+                return ;
+            }
+            int n = nr ;
+            R_xlen_t grain = std::max<R_xlen_t>( 1, RCPP11_PARALLEL_MINIMUM_SIZE / std::max(nr, 1) ) ;
+            R_xlen_t start = column_start(0), stride = mat.nrow() ;
+            parallel_for( 0, nc, grain, [=]( R_xlen_t begin, R_xlen_t end ){
+                for( R_xlen_t j=begin; j<end; j++){
+                    auto first = in + start + stride * j ;
+                    std::copy( first, first + n, out + j * n ) ;
+                }
+            }) ;
+        }
+
+        template <typename Target>
+        void apply_impl( Target& target, std::false_type ) const {
+            auto out = target.begin() ;
+            auto in = mat.begin() ;
+            for( int j=0; j<nc; j++, out += nr){
+                auto first = in + column_start(j) ;
+                std::copy( first, first + nr, out ) ;
+            }
+        }
+
+        const Mat& mat ;
+        int r0, c0, nr, nc ;
+    } ;
+
+}
+
+#endif
@@ -19,6 +19,12 @@ namespace Rcpp{
         
         template <typename Target>
         void apply( Target& target ) const ;
+        
+        template <typename Target>
+        void apply_serial( Target& target ) const ;
+        
+        template <typename Target>
+        void apply_parallel( Target& target ) const ;
     
         inline int nrow() const { return get_ref().nrow(); }
         inline int ncol() const { return get_ref().ncol(); }
@@ -3,13 +3,20 @@
     R_xlen_t offset(const std::string& name) const {
         SEXP names = RCPP_GET_NAMES(data) ;
         if( names == R_NilValue ) stop("vector has no names");
-        int n = size() ;
-    
-        SEXP* data = internal::r_vector_start<STRSXP>(names) ;
-        int index = std::find( data, data+n, Rf_mkChar(name.c_str()) ) - data ;
-        if( index == n ) stop("index out of bounds") ;
+        R_xlen_t index = internal::find_name( names, name ) ;
+        if( index < 0 ) stop("index out of bounds") ;
         return index ;
     }
+    
+    // 0-based positions of several names at once, e.g. x[ x.offsets(names) ]
+    Vector<INTSXP,Storage> offsets(const Vector<STRSXP,Storage>& targets) const {
+        SEXP names = RCPP_GET_NAMES(data) ;
+        if( names == R_NilValue ) stop("vector has no names");
+        Vector<INTSXP,Storage> res( targets.size() ) ;
+        R_xlen_t missing = internal::find_names( data, targets, res.begin() ) ;
+        if( missing >= 0 ) stop("no such name '%s'", CHAR(STRING_ELT(targets, missing)) ) ;
+        return res ;
+    }
         
     inline void set(SEXP x){                                                                  
         set_data(r_cast<RTYPE>(x)) ;                                                           